@@ -15,10 +15,12 @@
 #include "open_spiel/games/counter_air.h"
 
 #include <algorithm>
+#include <cstring>
 #include <memory>
 #include <utility>
 #include <vector>
 
+#include "open_spiel/games/counter_air_rules.h"
 #include "open_spiel/spiel_utils.h"
 #include "open_spiel/utils/tensor_view.h"
 
@@ -41,8 +43,13 @@ const GameType kGameType{
     /*provides_information_state_tensor=*/false,
     /*provides_observation_string=*/true,
     /*provides_observation_tensor=*/true,
-    /*parameter_specification=*/{}  // no parameters
-};
+    /*parameter_specification=*/
+    {{"blue_fighters", GameParameter(kDefaultConfig.blue_fighters)},
+     {"red_fighters", GameParameter(kDefaultConfig.red_fighters)},
+     {"red_sams", GameParameter(kDefaultConfig.red_sams)},
+     {"num_waves", GameParameter(kDefaultConfig.num_waves)},
+     {"num_aaa", GameParameter(kDefaultConfig.num_aaa)},
+     {"hit_threshold", GameParameter(kDefaultConfig.hit_threshold)}}};
 
 std::shared_ptr<const Game> Factory(const GameParameters &params) {
     return std::shared_ptr<const Game>(new CounterAirGame(params));
@@ -67,6 +74,59 @@ std::string StateToString(int state) {
     return std::to_string(state);
 }
 
+static_assert(sizeof(CompactState) == 42, "CompactState must not contain padding");
+
+uint64_t CompactStateKey(const CompactState &state) {
+    unsigned char bytes[sizeof(CompactState)];
+    std::memcpy(bytes, &state, sizeof(CompactState));
+    uint64_t hash = 0xcbf29ce484222325ULL;  // FNV-1a, then a splitmix64 finaliser.
+    for (unsigned char byte : bytes) {
+        hash = (hash ^ byte) * 0x100000001b3ULL;
+    }
+    hash = (hash ^ (hash >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    hash = (hash ^ (hash >> 27)) * 0x94d049bb133111ebULL;
+    return hash ^ (hash >> 31);
+}
+
+CompactState CanonicalCompactState(const CompactState &state) {
+    CompactState canonical = state;
+    canonical.num_moves = 0;
+    canonical.is_uav = false;
+    if (canonical.is_attacking) canonical.attacking_box = 0;
+    return canonical;
+}
+
+uint64_t CanonicalStateKey(const CompactState &state) {
+    return CompactStateKey(CanonicalCompactState(state));
+}
+
+namespace {
+
+// The game constants as the rules see them. For the default game they are
+// compile-time constants, so the hot path folds them into the code.
+template <bool kIsDefault>
+class RulesConfig {
+   public:
+    explicit RulesConfig(const CounterAirConfig &config) : config_(config) {}
+    int num_waves() const { return config_.num_waves; }
+    int num_aaa() const { return config_.num_aaa; }
+    int hit_threshold() const { return config_.hit_threshold; }
+
+   private:
+    const CounterAirConfig &config_;
+};
+
+template <>
+class RulesConfig<true> {
+   public:
+    explicit RulesConfig(const CounterAirConfig &) {}
+    static constexpr int num_waves() { return kDefaultConfig.num_waves; }
+    static constexpr int num_aaa() { return kDefaultConfig.num_aaa; }
+    static constexpr int hit_threshold() { return kDefaultConfig.hit_threshold; }
+};
+
+}  // namespace
+
 // -----board indexes-----
 // 0-1: Escort
 // 2-3: High Strike
@@ -79,6 +139,15 @@ std::string StateToString(int state) {
 // 16-17: AAA
 
 void CounterAirState::DoApplyAction(Action move) {
+    if (default_config_) {
+        ApplyMove(RulesConfig<true>(config_), move);
+    } else {
+        ApplyMove(RulesConfig<false>(config_), move);
+    }
+}
+
+template <typename Config>
+void CounterAirState::ApplyMove(const Config &config, Action move) {
     if (move == 11) {  // No legal action, and the players turn is changed.
         current_player_ = 1 - current_player_;
         num_moves_++;
@@ -90,7 +159,7 @@ void CounterAirState::DoApplyAction(Action move) {
     }
     if (move == 12) {  // No legal action, next phase
         if (current_phase_ == 5) {
-            max_low_strike_attacks_ = std::min(board_[6], 4);
+            max_low_strike_attacks_ = std::min(board_[6], config.num_aaa());
         }
         if (current_phase_ == 6) {
             max_active_sam_attacks_ = board_[10] + board_[11];
@@ -123,7 +192,7 @@ void CounterAirState::DoApplyAction(Action move) {
         is_attacking_ = true;
         current_player_ = 0;
 
-        if (CounterAirState::FinalRoundEnd()) {
+        if (current_wave_ == config.num_waves()) {
             if (blue_points_ > red_points_ + 2) {
                 outcome_ = 0;
             } else if (blue_points_ == red_points_ + 2) {
@@ -182,7 +251,7 @@ void CounterAirState::DoApplyAction(Action move) {
             red_placeable_sams_ -= move;
             board_[12] = red_placeable_sams_;
             red_placeable_sams_ = 0;
-            board_[16] = 4;
+            board_[16] = config.num_aaa();
             current_player_ = 1 - current_player_;
             current_phase_++;
             num_moves_++;
@@ -202,24 +271,28 @@ void CounterAirState::DoApplyAction(Action move) {
                 } else {
                     if (move == 0) {  // Blue does nothing
                         blue_hits_ += 2;
-                        if (blue_hits_ > 4) {
-                            blue_hits_ -= 4;
+                        if (blue_hits_ > config.hit_threshold()) {
+                            blue_hits_ -= config.hit_threshold();
                             board_[attacking_box_]--;
                             red_points_++;
                         }
                     } else if (move == 1) {  // Escort evades, and 1 damage is dealt to the attacking box.
+                        board_[0]--;
+                        board_[1]++;
                         blue_hits_++;
-                        if (blue_hits_ >= 4) {
-                            blue_hits_ -= 4;
-                            board_[attacking_box_]--;
+                        if (blue_hits_ >= config.hit_threshold()) {
+                            blue_hits_ -= config.hit_threshold();
+                            if (board_[attacking_box_] > 0) {
+                                board_[attacking_box_]--;
+                            } else {  // The last attacked escort was the one evading.
+                                board_[attacking_box_ + 1]--;
+                            }
                             red_points_++;
                         }
-                        board_[0]--;
-                        board_[1]++;
                     } else if (move == 2 || move == 3) {  // fighter in the high strike/low strike box chooses to evade, taking only 1 hit and preventing further attacks from this fighter in high-strike
                         blue_hits_++;
-                        if (blue_hits_ >= 4) {
-                            blue_hits_ -= 4;
+                        if (blue_hits_ >= config.hit_threshold()) {
+                            blue_hits_ -= config.hit_threshold();
                             board_[attacking_box_]--;
                             red_points_++;
                         } else {
@@ -247,8 +320,8 @@ void CounterAirState::DoApplyAction(Action move) {
                 } else {
                     if (move == 1) {  // red player chooses to evade
                         red_hits_++;  // blue scores 1 hit
-                        if (red_hits_ >= 4) {
-                            red_hits_ -= 4;
+                        if (red_hits_ >= config.hit_threshold()) {
+                            red_hits_ -= config.hit_threshold();
                             board_[8]--;
                             blue_points_++;
                         } else {
@@ -257,8 +330,8 @@ void CounterAirState::DoApplyAction(Action move) {
                         }
                     } else if (move == 0) {
                         red_hits_ += 2;
-                        if (red_hits_ >= 4) {
-                            red_hits_ -= 4;
+                        if (red_hits_ >= config.hit_threshold()) {
+                            red_hits_ -= config.hit_threshold();
                             board_[8]--;
                             blue_points_++;
                         }
@@ -287,15 +360,15 @@ void CounterAirState::DoApplyAction(Action move) {
                 } else {              // Blue defends
                     if (move == 0) {  // Blue does nothing
                         blue_hits_ += 2;
-                        if (blue_hits_ >= 4) {
-                            blue_hits_ -= 4;
+                        if (blue_hits_ >= config.hit_threshold()) {
+                            blue_hits_ -= config.hit_threshold();
                             board_[2]--;
                             red_points_++;
                         }
                     } else if (move == 1) {  // High Strike evades and takes 1 damage
                         blue_hits_++;
-                        if (blue_hits_ >= 4) {
-                            blue_hits_ -= 4;
+                        if (blue_hits_ >= config.hit_threshold()) {
+                            blue_hits_ -= config.hit_threshold();
                             board_[2]--;
                             red_points_++;
                         } else {
@@ -304,8 +377,8 @@ void CounterAirState::DoApplyAction(Action move) {
                         }
                     } else if (move == 2) {  // SEAD tries to supress the SAMS, and so only 1 damage is taken by the High-strike fighter.
                         blue_hits_++;
-                        if (blue_hits_ >= 4) {
-                            blue_hits_ -= 4;
+                        if (blue_hits_ >= config.hit_threshold()) {
+                            blue_hits_ -= config.hit_threshold();
                             board_[2]--;
                             red_points_++;
                         }
@@ -313,8 +386,8 @@ void CounterAirState::DoApplyAction(Action move) {
                         board_[5]++;
                     } else if (move == 3) {
                         blue_hits_++;
-                        if (blue_hits_ >= 4) {
-                            blue_hits_ -= 4;
+                        if (blue_hits_ >= config.hit_threshold()) {
+                            blue_hits_ -= config.hit_threshold();
                             board_[6]--;
                             red_points_++;
                         }
@@ -340,8 +413,8 @@ void CounterAirState::DoApplyAction(Action move) {
                     if (move == 0) {
                         if (attacking_box_ == 10) {
                             red_hits_++;
-                            if (red_hits_ >= 4) {
-                                red_hits_ -= 4;
+                            if (red_hits_ >= config.hit_threshold()) {
+                                red_hits_ -= config.hit_threshold();
                                 board_[10]--;
                                 blue_points_++;
                             } else {
@@ -390,8 +463,8 @@ void CounterAirState::DoApplyAction(Action move) {
                     attacking_box_ = 12;
                 }
             }
-            if (red_hits_ >= 4) {
-                red_hits_ -= 4;
+            if (red_hits_ >= config.hit_threshold()) {
+                red_hits_ -= config.hit_threshold();
                 board_[attacking_box_]--;
                 blue_points_++;
             }
@@ -418,8 +491,8 @@ void CounterAirState::DoApplyAction(Action move) {
                     attacking_box_ = 12;
                 }
             }
-            if (red_hits_ >= 4) {
-                red_hits_ -= 4;
+            if (red_hits_ >= config.hit_threshold()) {
+                red_hits_ -= config.hit_threshold();
                 board_[attacking_box_]--;
                 blue_points_++;
             }
@@ -440,8 +513,8 @@ void CounterAirState::DoApplyAction(Action move) {
                 } else {
                     attacking_box_ = 10;
                 }
-                if (red_hits_ >= 4) {
-                    red_hits_ -= 4;
+                if (red_hits_ >= config.hit_threshold()) {
+                    red_hits_ -= config.hit_threshold();
                     board_[attacking_box_]--;
                     blue_points_++;
                 }
@@ -454,8 +527,8 @@ void CounterAirState::DoApplyAction(Action move) {
                 } else {
                     attacking_box_ = 12;
                 }
-                if (red_hits_ >= 4) {
-                    red_hits_ -= 4;
+                if (red_hits_ >= config.hit_threshold()) {
+                    red_hits_ -= config.hit_threshold();
                     board_[attacking_box_]--;
                     blue_points_++;
                 }
@@ -494,35 +567,35 @@ std::vector<Action> CounterAirState::LegalActions() const {
     switch (current_phase_) {
         case 0:  // Place Escort
             // std::cout << "CASE 0  ";
-            for (int i; i <= blue_placeable_fighters_; i++) {
+            for (int i = 0; i <= blue_placeable_fighters_; i++) {
                 moves.push_back(i);
             }
             break;
 
         case 1:  // Place High Strike
             // std::cout << "CASE 1  ";
-            for (int i; i <= blue_placeable_fighters_; i++) {
+            for (int i = 0; i <= blue_placeable_fighters_; i++) {
                 moves.push_back(i);
             }
             break;
 
         case 2:  // Place SEAD/Low Strke
             // std::cout << "CASE 2  ";
-            for (int i; i <= blue_placeable_fighters_; i++) {
+            for (int i = 0; i <= blue_placeable_fighters_; i++) {
                 moves.push_back(i);
             }
             break;
 
         case 3:  // Place Intercept/Airbase
             // std::cout << "CASE 3  ";
-            for (int i; i <= red_placeable_fighters_; i++) {
+            for (int i = 0; i <= red_placeable_fighters_; i++) {
                 moves.push_back(i);
             }
             break;
 
         case 4:  // Place Active/Passive SAM
             // std::cout << "CASE 4  ";
-            for (int i; i <= red_placeable_sams_; i++) {
+            for (int i = 0; i <= red_placeable_sams_; i++) {
                 moves.push_back(i);
             }
             break;
@@ -685,10 +758,78 @@ std::string CounterAirState::ActionToString(Player player,
 //   return BoardHasLine(board_, player);
 // }
 
-bool CounterAirState::FinalRoundEnd() const { return current_wave_ == 5; }
+bool CounterAirState::FinalRoundEnd() const { return current_wave_ == config_.num_waves; }
 
-CounterAirState::CounterAirState(std::shared_ptr<const Game> game) : State(game) {
+CounterAirState::CounterAirState(std::shared_ptr<const Game> game)
+    : State(game),
+      config_(static_cast<const CounterAirGame &>(*game).config()),
+      default_config_(config_ == kDefaultConfig) {
     std::fill(begin(board_), end(board_), 0);
+    blue_placeable_fighters_ = config_.blue_fighters;
+    red_placeable_fighters_ = config_.red_fighters;
+    red_placeable_sams_ = config_.red_sams;
+}
+
+CounterAirState::CounterAirState(std::shared_ptr<const Game> game,
+                                 const CompactState &compact)
+    : CounterAirState(game) {
+    for (int i = 0; i < kBoardSize; i++) {
+        board_[i] = compact.board[i];
+    }
+    num_moves_ = compact.num_moves;
+    current_player_ = compact.current_player;
+    outcome_ = compact.outcome;
+    current_wave_ = compact.current_wave;
+    current_phase_ = compact.current_phase;
+    blue_hits_ = compact.blue_hits;
+    red_hits_ = compact.red_hits;
+    blue_points_ = compact.blue_points;
+    red_points_ = compact.red_points;
+    blue_placeable_fighters_ = compact.blue_placeable_fighters;
+    red_placeable_fighters_ = compact.red_placeable_fighters;
+    red_placeable_sams_ = compact.red_placeable_sams;
+    attacking_box_ = compact.attacking_box;
+    low_strike_attacks_ = compact.low_strike_attacks;
+    max_low_strike_attacks_ = compact.max_low_strike_attacks;
+    active_sam_attacks_ = compact.active_sam_attacks;
+    max_active_sam_attacks_ = compact.max_active_sam_attacks;
+    passive_sam_attacks_ = compact.passive_sam_attacks;
+    max_passive_sam_attacks_ = compact.max_passive_sam_attacks;
+    airbase_attacks_ = compact.airbase_attacks;
+    max_airbase_attacks_ = compact.max_airbase_attacks;
+    is_uav_ = compact.is_uav;
+    is_attacking_ = compact.is_attacking;
+}
+
+CompactState CounterAirState::ToCompact() const {
+    CompactState compact;
+    for (int i = 0; i < kBoardSize; i++) {
+        compact.board[i] = board_[i];
+    }
+    compact.num_moves = num_moves_;
+    compact.current_player = current_player_;
+    compact.outcome = outcome_;
+    compact.current_wave = current_wave_;
+    compact.current_phase = current_phase_;
+    compact.blue_hits = blue_hits_;
+    compact.red_hits = red_hits_;
+    compact.blue_points = blue_points_;
+    compact.red_points = red_points_;
+    compact.blue_placeable_fighters = blue_placeable_fighters_;
+    compact.red_placeable_fighters = red_placeable_fighters_;
+    compact.red_placeable_sams = red_placeable_sams_;
+    compact.attacking_box = attacking_box_;
+    compact.low_strike_attacks = low_strike_attacks_;
+    compact.max_low_strike_attacks = max_low_strike_attacks_;
+    compact.active_sam_attacks = active_sam_attacks_;
+    compact.max_active_sam_attacks = max_active_sam_attacks_;
+    compact.passive_sam_attacks = passive_sam_attacks_;
+    compact.max_passive_sam_attacks = max_passive_sam_attacks_;
+    compact.airbase_attacks = airbase_attacks_;
+    compact.max_airbase_attacks = max_airbase_attacks_;
+    compact.is_uav = is_uav_;
+    compact.is_attacking = is_attacking_;
+    return compact;
 }
 
 std::string CounterAirState::ToString() const {
@@ -839,39 +980,62 @@ void CounterAirState::ObservationTensor(Player player,
                                         absl::Span<float> values) const {
     SPIEL_CHECK_GE(player, 0);
     SPIEL_CHECK_LT(player, num_players_);
+    CompactObservationTensor(ToCompact(), values);
+}
 
+void CompactObservationTensor(const CompactState &state, absl::Span<float> values) {
     // Treat `values` as a 2-d tensor.
-    TensorView<1> view(values, {246}, true);
+    TensorView<1> view(values, {kObservationSize}, true);
     for (int i = 0; i < 7; i++) {
-        view[{static_cast<int>(i * 11 + board_[i])}] = 1.0;          // Blue fighters
-        view[{static_cast<int>(87 + i * 5 + board_[8 + i])}] = 1.0;  // Red fighters/SAMs
+        view[{static_cast<int>(i * 11 + state.board[i])}] = 1.0;          // Blue fighters
+        view[{static_cast<int>(87 + i * 5 + state.board[8 + i])}] = 1.0;  // Red fighters/SAMs
     }
-    view[{static_cast<int>(127 + board_[16])}] = 1.0;  // Attacking AAA
-    view[{static_cast<int>(132 + board_[17])}] = 1.0;  // Evading AAA
-    view[{static_cast<int>(137 + current_wave_)}] = 1.0;
-    view[{static_cast<int>(142 + current_phase_)}] = 1.0;
-    view[{static_cast<int>(153 + blue_hits_)}] = 1.0;
-    view[{static_cast<int>(157 + red_hits_)}] = 1.0;
-    view[{static_cast<int>(161 + blue_points_)}] = 1.0;
-    view[{static_cast<int>(170 + red_points_)}] = 1.0;
-    view[{static_cast<int>(181 + blue_placeable_fighters_)}] = 1.0;
-    view[{static_cast<int>(192 + red_placeable_fighters_)}] = 1.0;
-    view[{static_cast<int>(197 + red_placeable_sams_)}] = 1.0;
-    view[{static_cast<int>(202 + attacking_box_)}] = 1.0;
-    view[{static_cast<int>(210 + int(is_attacking_))}] = 1.0;
-    view[{static_cast<int>(212 + current_player_)}] = 1.0;
-    view[{static_cast<int>(214 + low_strike_attacks_)}] = 1.0;
-    view[{static_cast<int>(218 + max_low_strike_attacks_)}] = 1.0;
-    view[{static_cast<int>(222 + active_sam_attacks_)}] = 1.0;
-    view[{static_cast<int>(226 + max_active_sam_attacks_)}] = 1.0;
-    view[{static_cast<int>(230 + passive_sam_attacks_)}] = 1.0;
-    view[{static_cast<int>(234 + max_passive_sam_attacks_)}] = 1.0;
-    view[{static_cast<int>(238 + airbase_attacks_)}] = 1.0;
-    view[{static_cast<int>(242 + max_airbase_attacks_)}] = 1.0;
-
-    for (int i = 0; i < 246; i++) {
-        // std::cout << std::to_string(view[{static_cast<int>(i)}]);
+    view[{static_cast<int>(127 + state.board[16])}] = 1.0;  // Attacking AAA
+    view[{static_cast<int>(132 + state.board[17])}] = 1.0;  // Evading AAA
+    view[{static_cast<int>(137 + state.current_wave)}] = 1.0;
+    view[{static_cast<int>(142 + state.current_phase)}] = 1.0;
+    view[{static_cast<int>(153 + state.blue_hits)}] = 1.0;
+    view[{static_cast<int>(157 + state.red_hits)}] = 1.0;
+    view[{static_cast<int>(161 + state.blue_points)}] = 1.0;
+    view[{static_cast<int>(170 + state.red_points)}] = 1.0;
+    view[{static_cast<int>(181 + state.blue_placeable_fighters)}] = 1.0;
+    view[{static_cast<int>(192 + state.red_placeable_fighters)}] = 1.0;
+    view[{static_cast<int>(197 + state.red_placeable_sams)}] = 1.0;
+    view[{static_cast<int>(202 + state.attacking_box)}] = 1.0;
+    view[{static_cast<int>(210 + int(state.is_attacking))}] = 1.0;
+    view[{static_cast<int>(212 + state.current_player)}] = 1.0;
+    view[{static_cast<int>(214 + state.low_strike_attacks)}] = 1.0;
+    view[{static_cast<int>(218 + state.max_low_strike_attacks)}] = 1.0;
+    view[{static_cast<int>(222 + state.active_sam_attacks)}] = 1.0;
+    view[{static_cast<int>(226 + state.max_active_sam_attacks)}] = 1.0;
+    view[{static_cast<int>(230 + state.passive_sam_attacks)}] = 1.0;
+    view[{static_cast<int>(234 + state.max_passive_sam_attacks)}] = 1.0;
+    view[{static_cast<int>(238 + state.airbase_attacks)}] = 1.0;
+    // Four airbase attacks would land one past the end of the tensor.
+    view[{static_cast<int>(242 + std::min<int>(state.max_airbase_attacks, 3))}] = 1.0;
+}
+
+int CounterAirState::ExpandChildren(absl::Span<ExpandedChild> children,
+                                    absl::Span<float> observations) const {
+    const RuleTable &rules = static_cast<const CounterAirGame &>(*game_).rules();
+    const CompactState parent = ToCompact();
+    const uint16_t legal = RuleLegalMask(rules, parent);
+    int num_children = 0;
+    for (int action = 0; action < kNumDistinctActions; action++) {
+        if (!(legal & (1 << action))) continue;
+        SPIEL_CHECK_LT(num_children, static_cast<int>(children.size()));
+        ExpandedChild &child = children[num_children];
+        child.state = parent;
+        child.action = action;
+        RuleApplyAction(rules, &child.state, action);
+        if (!observations.empty()) {
+            CompactObservationTensor(
+                child.state,
+                observations.subspan(num_children * kObservationSize, kObservationSize));
+        }
+        num_children++;
     }
+    return num_children;
 }
 
 void CounterAirState::UndoAction(Player player, Action move) {
@@ -893,7 +1057,34 @@ std::string CounterAirGame::ActionToString(Player player,
 }
 
 CounterAirGame::CounterAirGame(const GameParameters &params)
-    : Game(kGameType, params) {}
+    : Game(kGameType, params) {
+    config_.blue_fighters = ParameterValue<int>("blue_fighters");
+    config_.red_fighters = ParameterValue<int>("red_fighters");
+    config_.red_sams = ParameterValue<int>("red_sams");
+    config_.num_waves = ParameterValue<int>("num_waves");
+    config_.num_aaa = ParameterValue<int>("num_aaa");
+    config_.hit_threshold = ParameterValue<int>("hit_threshold");
+    // The observation tensor is laid out for the default forces, so only
+    // smaller games are supported.
+    SPIEL_CHECK_GE(config_.blue_fighters, 0);
+    SPIEL_CHECK_LE(config_.blue_fighters, kDefaultConfig.blue_fighters);
+    SPIEL_CHECK_GE(config_.red_fighters, 0);
+    SPIEL_CHECK_LE(config_.red_fighters, kDefaultConfig.red_fighters);
+    SPIEL_CHECK_GE(config_.red_sams, 0);
+    SPIEL_CHECK_LE(config_.red_sams, kDefaultConfig.red_sams);
+    SPIEL_CHECK_GE(config_.num_waves, 1);
+    SPIEL_CHECK_LE(config_.num_waves, kDefaultConfig.num_waves);
+    SPIEL_CHECK_GE(config_.num_aaa, 0);
+    SPIEL_CHECK_LE(config_.num_aaa, kDefaultConfig.num_aaa);
+    SPIEL_CHECK_GE(config_.hit_threshold, 1);
+    SPIEL_CHECK_LE(config_.hit_threshold, kDefaultConfig.hit_threshold);
+    if (config_ == kDefaultConfig) {
+        rules_ = std::shared_ptr<const RuleTable>(&DefaultRuleTable(),
+                                                  [](const RuleTable *) {});
+    } else {
+        rules_ = std::make_shared<const RuleTable>(MakeRuleTable(config_));
+    }
+}
 
 }  // namespace counter_air
 }  // namespace open_spiel
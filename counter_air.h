@@ -16,6 +16,7 @@
 #define OPEN_SPIEL_GAMES_COUNTER_AIR_H_
 
 #include <array>
+#include <cstdint>
 #include <map>
 #include <memory>
 #include <string>
@@ -26,7 +27,15 @@
 // Simple game of Noughts and Crosses:
 // https://en.wikipedia.org/wiki/Tic-tac-toe
 //
-// Parameters: none
+// Parameters:
+//   "blue_fighters"  int  Blue fighters at the start       (default = 10)
+//   "red_fighters"   int  Red fighters at the start        (default = 4)
+//   "red_sams"       int  Red SAMs at the start            (default = 4)
+//   "num_waves"      int  Waves before the game is scored  (default = 5)
+//   "num_aaa"        int  AAA counters placed every wave   (default = 4)
+//   "hit_threshold"  int  Hits needed to remove a counter  (default = 4)
+//
+// Only configurations up to the default sizes are supported.
 
 namespace open_spiel {
 namespace counter_air {
@@ -35,11 +44,88 @@ namespace counter_air {
 inline constexpr int kNumPlayers = 2;
 inline constexpr int kMaxCountersPerBox = 10;
 inline constexpr int kNumBoxes = 9;  // The amount of boxes the game pieces may be placed in.
+inline constexpr int kBoardSize = 2 * kNumBoxes;  // Attacking/evading count per box.
+inline constexpr int kNumDistinctActions = 13;
+inline constexpr int kObservationSize = 246;
+
+// Game constants set by the parameters.
+struct CounterAirConfig {
+    int blue_fighters = 10;
+    int red_fighters = 4;
+    int red_sams = 4;
+    int num_waves = 5;
+    int num_aaa = 4;
+    int hit_threshold = 4;
+
+    constexpr bool operator==(const CounterAirConfig &other) const {
+        return blue_fighters == other.blue_fighters &&
+               red_fighters == other.red_fighters && red_sams == other.red_sams &&
+               num_waves == other.num_waves && num_aaa == other.num_aaa &&
+               hit_threshold == other.hit_threshold;
+    }
+};
+
+inline constexpr CounterAirConfig kDefaultConfig{};
+
+// Trivially copyable snapshot of everything that changes during play. Used as
+// the storage format for offline tables and as the input of StateKey().
+struct CompactState {
+    std::array<int8_t, kBoardSize> board;
+    int16_t num_moves;
+    int8_t current_player;
+    int8_t outcome;
+    int8_t current_wave;
+    int8_t current_phase;
+    int8_t blue_hits;
+    int8_t red_hits;
+    int8_t blue_points;
+    int8_t red_points;
+    int8_t blue_placeable_fighters;
+    int8_t red_placeable_fighters;
+    int8_t red_placeable_sams;
+    int8_t attacking_box;
+    int8_t low_strike_attacks;
+    int8_t max_low_strike_attacks;
+    int8_t active_sam_attacks;
+    int8_t max_active_sam_attacks;
+    int8_t passive_sam_attacks;
+    int8_t max_passive_sam_attacks;
+    int8_t airbase_attacks;
+    int8_t max_airbase_attacks;
+    bool is_uav;
+    bool is_attacking;
+};
+
+// 64-bit hash of a compact state, stable across runs and platforms.
+uint64_t CompactStateKey(const CompactState &state);
+
+// The state with the fields that cannot affect the rest of the game cleared,
+// so that transpositions compare equal: num_moves (read only by the pass-loop
+// guard), is_uav (never read) and attacking_box while attacking (the attack
+// sets it before any defence reads it). Legal moves, successors and values
+// depend only on the canonical state; the observation tensor does not, as it
+// shows attacking_box.
+CompactState CanonicalCompactState(const CompactState &state);
+// CompactStateKey() of the canonical state.
+uint64_t CanonicalStateKey(const CompactState &state);
+
+// Writes the observation tensor of a compact state.
+void CompactObservationTensor(const CompactState &state, absl::Span<float> values);
+
+// A successor written by CounterAirState::ExpandChildren().
+struct ExpandedChild {
+    CompactState state;
+    int8_t action;
+};
+
+struct RuleTable;
 
 // State of an in-play game.
 class CounterAirState : public State {
    public:
     CounterAirState(std::shared_ptr<const Game> game);
+    // Restores a compact state. The history is not restored.
+    CounterAirState(std::shared_ptr<const Game> game, const CompactState &compact);
 
     CounterAirState(const CounterAirState &) = default;
     CounterAirState &operator=(const CounterAirState &) = default;
@@ -60,15 +146,30 @@ class CounterAirState : public State {
     std::vector<Action> LegalActions() const override;
 
     Player outcome() const { return outcome_; }
+    const CounterAirConfig &config() const { return config_; }
+    CompactState ToCompact() const;
+    // Writes every successor and the action leading to it, in action order,
+    // and returns their number (at most kNumDistinctActions). When
+    // `observations` is not empty, the observation of child i is written to
+    // observations[i * kObservationSize, (i + 1) * kObservationSize).
+    int ExpandChildren(absl::Span<ExpandedChild> children,
+                       absl::Span<float> observations = {}) const;
+    uint64_t StateKey() const { return CompactStateKey(ToCompact()); }
+    uint64_t CanonicalKey() const { return CanonicalStateKey(ToCompact()); }
 
     // protected:
     std::array<int, 18> board_;
     std::array<int, 18> board_zero_;  // Let board be zerod at phase 0.
 
     void DoApplyAction(Action move) override;
+    // DoApplyAction() for the constants in `config`, see RulesConfig.
+    template <typename Config>
+    void ApplyMove(const Config &config, Action move);
 
     // private:
     bool FinalRoundEnd() const;  // Is the final round finished?
+    CounterAirConfig config_;
+    bool default_config_ = true;  // Selects the constant-folded rules.
     Player current_player_ = 0;  // Player zero goes first
     Player outcome_ = kInvalidPlayer;
     int current_wave_ = 0;
@@ -98,7 +199,7 @@ class CounterAirState : public State {
 class CounterAirGame : public Game {
    public:
     explicit CounterAirGame(const GameParameters &params);
-    int NumDistinctActions() const override { return 13; }  // DUBBELKOLLA
+    int NumDistinctActions() const override { return kNumDistinctActions; }
     std::unique_ptr<State> NewInitialState() const override {
         return std::unique_ptr<State>(new CounterAirState(shared_from_this()));
     }
@@ -107,10 +208,16 @@ class CounterAirGame : public Game {
     absl::optional<double> UtilitySum() const override { return 0; }
     double MaxUtility() const override { return 1; }
     std::vector<int> ObservationTensorShape() const override {
-        return {246};  // ÄNDRA
+        return {kObservationSize};
     }
     int MaxGameLength() const override { return 1000; }
     std::string ActionToString(Player player, Action action_id) const override;
+    const CounterAirConfig &config() const { return config_; }
+    const RuleTable &rules() const { return *rules_; }
+
+   private:
+    CounterAirConfig config_;
+    std::shared_ptr<const RuleTable> rules_;  // Table engine for config_.
 };
 
 std::string PlayerToString(Player player);
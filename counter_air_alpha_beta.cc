@@ -0,0 +1,142 @@
+// Copyright 2019 DeepMind Technologies Limited
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "open_spiel/games/counter_air_alpha_beta.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "open_spiel/games/counter_air_rules.h"
+#include "open_spiel/spiel_utils.h"
+
+namespace open_spiel {
+namespace counter_air {
+namespace {
+
+// Values are searched as integers so they fit the transposition table.
+constexpr int kValueScale = 10000;
+constexpr int kInfinity = 32000;
+constexpr size_t kOwnTableSizeMb = 16;
+
+int ScaledValue(double value) { return std::lround(value * kValueScale); }
+
+}  // namespace
+
+CounterAirAlphaBeta::CounterAirAlphaBeta(std::shared_ptr<const Game> game,
+                                         const CounterAirEvaluator &evaluator,
+                                         TranspositionTable *table)
+    : game_(game),
+      rules_(static_cast<const CounterAirGame &>(*game).rules()),
+      evaluator_(evaluator),
+      table_(table) {
+    if (table_ == nullptr) {
+        own_table_ = std::make_unique<TranspositionTable>(
+            TranspositionTableOptions{kOwnTableSizeMb});
+        table_ = own_table_.get();
+    }
+}
+
+AlphaBetaResult CounterAirAlphaBeta::Search(const CounterAirState &state,
+                                            int max_depth) {
+    SPIEL_CHECK_FALSE(state.IsTerminal());
+    SPIEL_CHECK_GE(max_depth, 1);
+    SPIEL_CHECK_LE(max_depth, TranspositionTable::kMaxDepth);
+    const CompactState root = state.ToCompact();
+    table_->NewSearch();
+    nodes_ = 0;
+    AlphaBetaResult result;
+    for (int depth = 1; depth <= max_depth; depth++) {
+        Action best_action = kInvalidAction;
+        const int value = AlphaBeta(root, depth, -kInfinity, kInfinity, &best_action);
+        result.best_action = best_action;
+        result.value = static_cast<double>(value) / kValueScale;
+        result.depth = depth;
+    }
+    result.nodes = nodes_;
+    return result;
+}
+
+int CounterAirAlphaBeta::AlphaBeta(const CompactState &state, int depth, int alpha,
+                                   int beta, Action *best_action) {
+    nodes_++;
+    const uint16_t legal = RuleLegalMask(rules_, state);
+    if (legal == 0 || depth == 0) return ScaledValue(evaluator_.Evaluate(state));
+
+    const uint64_t key = CanonicalStateKey(state);
+    TTEntry entry;
+    Action table_move = kInvalidAction;
+    if (table_->Probe(key, &entry)) {
+        table_move = entry.move;
+        // num_moves does not count plies, so a state recurs at other depths.
+        // Only bounds of the same depth are used, which keeps the result equal
+        // to a fixed-depth minimax whatever else the table holds.
+        if (entry.depth == depth) {
+            if (entry.bound == TTBound::kExact) {
+                *best_action = entry.move;
+                return entry.value;
+            } else if (entry.bound == TTBound::kLower) {
+                alpha = std::max(alpha, entry.value);
+            } else if (entry.bound == TTBound::kUpper) {
+                beta = std::min(beta, entry.value);
+            }
+            if (alpha >= beta) {
+                *best_action = entry.move;
+                return entry.value;
+            }
+        }
+    }
+
+    // The move stored for this state goes first, then the rest in order.
+    Action moves[kNumDistinctActions];
+    int num_moves = 0;
+    if (table_move != kInvalidAction && (legal & (1 << table_move))) {
+        moves[num_moves++] = table_move;
+    }
+    for (Action action = 0; action < kNumDistinctActions; action++) {
+        if ((legal & (1 << action)) && action != table_move) moves[num_moves++] = action;
+    }
+
+    const int alpha_orig = alpha;
+    const int beta_orig = beta;
+    const bool maximising = state.current_player == 0;
+    int best_value = maximising ? -kInfinity : kInfinity;
+    for (int i = 0; i < num_moves; i++) {
+        CompactState child = state;
+        RuleApplyAction(rules_, &child, moves[i]);
+        Action child_best;
+        const int value = AlphaBeta(child, depth - 1, alpha, beta, &child_best);
+        if (maximising ? value > best_value : value < best_value) {
+            best_value = value;
+            *best_action = moves[i];
+        }
+        if (maximising) {
+            alpha = std::max(alpha, value);
+        } else {
+            beta = std::min(beta, value);
+        }
+        if (alpha >= beta) break;
+    }
+
+    TTBound bound = TTBound::kExact;
+    if (best_value <= alpha_orig) {
+        bound = TTBound::kUpper;
+    } else if (best_value >= beta_orig) {
+        bound = TTBound::kLower;
+    }
+    table_->Store(key, best_value, depth, bound, *best_action);
+    return best_value;
+}
+
+}  // namespace counter_air
+}  // namespace open_spiel
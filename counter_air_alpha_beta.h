@@ -0,0 +1,68 @@
+// Copyright 2019 DeepMind Technologies Limited
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef OPEN_SPIEL_GAMES_COUNTER_AIR_ALPHA_BETA_H_
+#define OPEN_SPIEL_GAMES_COUNTER_AIR_ALPHA_BETA_H_
+
+#include <cstdint>
+#include <memory>
+
+#include "open_spiel/games/counter_air.h"
+#include "open_spiel/games/counter_air_eval.h"
+#include "open_spiel/games/counter_air_tt.h"
+#include "open_spiel/spiel.h"
+
+// Depth-limited alpha-beta search for counter_air, with Blue maximising and
+// Red minimising Blue's return. Positions at the depth limit are scored by
+// CounterAirEvaluator. The search deepens iteratively and keeps bounds and
+// best moves in a TranspositionTable, keyed by CanonicalStateKey(), which can
+// be shared with other searches using the same evaluator; the best move of
+// the previous iteration is searched first.
+
+namespace open_spiel {
+namespace counter_air {
+
+struct AlphaBetaResult {
+    Action best_action = kInvalidAction;
+    double value = 0;  // Blue's return, in [-1, 1].
+    int depth = 0;
+    int64_t nodes = 0;
+};
+
+class CounterAirAlphaBeta {
+   public:
+    // Uses a table of its own if `table` is null.
+    CounterAirAlphaBeta(std::shared_ptr<const Game> game,
+                        const CounterAirEvaluator &evaluator,
+                        TranspositionTable *table = nullptr);
+
+    // The state must not be terminal.
+    AlphaBetaResult Search(const CounterAirState &state, int max_depth);
+
+   private:
+    int AlphaBeta(const CompactState &state, int depth, int alpha, int beta,
+                  Action *best_action);
+
+    std::shared_ptr<const Game> game_;
+    const RuleTable &rules_;
+    CounterAirEvaluator evaluator_;
+    std::unique_ptr<TranspositionTable> own_table_;
+    TranspositionTable *table_;
+    int64_t nodes_ = 0;
+};
+
+}  // namespace counter_air
+}  // namespace open_spiel
+
+#endif  // OPEN_SPIEL_GAMES_COUNTER_AIR_ALPHA_BETA_H_
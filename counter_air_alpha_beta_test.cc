@@ -0,0 +1,134 @@
+// Copyright 2019 DeepMind Technologies Limited
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "open_spiel/games/counter_air_alpha_beta.h"
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "open_spiel/games/counter_air.h"
+#include "open_spiel/games/counter_air_eval.h"
+#include "open_spiel/games/counter_air_tt.h"
+#include "open_spiel/spiel.h"
+#include "open_spiel/spiel_utils.h"
+
+namespace open_spiel {
+namespace counter_air {
+namespace {
+
+// Plain minimax over State objects, scored like the search.
+double MinimaxValue(const State& state, int depth,
+                    const CounterAirEvaluator& evaluator) {
+  if (state.IsTerminal() || depth == 0) {
+    const double value =
+        evaluator.Evaluate(static_cast<const CounterAirState&>(state));
+    return std::round(value * 10000) / 10000;
+  }
+  std::vector<double> values;
+  for (Action action : state.LegalActions()) {
+    values.push_back(MinimaxValue(*state.Child(action), depth - 1, evaluator));
+  }
+  return state.CurrentPlayer() == 0
+             ? *std::max_element(values.begin(), values.end())
+             : *std::min_element(values.begin(), values.end());
+}
+
+void MatchesMinimaxTest() {
+  std::shared_ptr<const Game> game = LoadGame("counter_air");
+  CounterAirEvaluator evaluator;
+  TranspositionTable table({/*size_mb=*/4});
+  CounterAirAlphaBeta search(game, evaluator, &table);
+  std::mt19937 rng(0);
+  for (int i = 0; i < 10; i++) {
+    std::unique_ptr<State> state = game->NewInitialState();
+    while (!state->IsTerminal()) {
+      if (rng() % 10 == 0) {
+        const AlphaBetaResult result =
+            search.Search(static_cast<const CounterAirState&>(*state), 4);
+        SPIEL_CHECK_EQ(result.depth, 4);
+        SPIEL_CHECK_GT(result.nodes, 0);
+        SPIEL_CHECK_FLOAT_NEAR(result.value, MinimaxValue(*state, 4, evaluator),
+                               1e-9);
+        // The best action achieves the value.
+        std::unique_ptr<State> child = state->Child(result.best_action);
+        SPIEL_CHECK_FLOAT_NEAR(MinimaxValue(*child, 3, evaluator), result.value,
+                               1e-9);
+      }
+      std::vector<Action> actions = state->LegalActions();
+      state->ApplyAction(actions[rng() % actions.size()]);
+    }
+  }
+  SPIEL_CHECK_GT(table.Stats().hits, 0);
+}
+
+void SolvesSmallGameTest() {
+  // Deep enough to reach every terminal state, the search is exact.
+  std::shared_ptr<const Game> game =
+      LoadGame("counter_air", {{"blue_fighters", GameParameter(1)},
+                               {"red_fighters", GameParameter(1)},
+                               {"red_sams", GameParameter(1)},
+                               {"num_waves", GameParameter(1)},
+                               {"num_aaa", GameParameter(1)},
+                               {"hit_threshold", GameParameter(1)}});
+  const auto& config = static_cast<const CounterAirGame&>(*game).config();
+  CounterAirAlphaBeta search(game, CounterAirEvaluator(config));
+  std::unique_ptr<State> state = game->NewInitialState();
+  const AlphaBetaResult result =
+      search.Search(static_cast<const CounterAirState&>(*state), 60);
+  SPIEL_CHECK_TRUE(result.value == -1 || result.value == 0 || result.value == 1);
+}
+
+void ZeroUnitsTest() {
+  // Forces configured empty must not make the evaluation NaN.
+  std::shared_ptr<const Game> game =
+      LoadGame("counter_air", {{"red_sams", GameParameter(0)},
+                               {"num_aaa", GameParameter(0)}});
+  const auto& config = static_cast<const CounterAirGame&>(*game).config();
+  const CounterAirEvaluator evaluator(config);
+  CounterAirAlphaBeta search(game, evaluator);
+  std::mt19937 rng(2);
+  for (int i = 0; i < 5; i++) {
+    std::unique_ptr<State> state = game->NewInitialState();
+    while (!state->IsTerminal()) {
+      const auto& counter_air_state = static_cast<const CounterAirState&>(*state);
+      const double value = evaluator.Evaluate(counter_air_state);
+      SPIEL_CHECK_FALSE(std::isnan(value));
+      SPIEL_CHECK_GE(value, -1);
+      SPIEL_CHECK_LE(value, 1);
+      if (rng() % 10 == 0) {
+        const AlphaBetaResult result = search.Search(counter_air_state, 3);
+        SPIEL_CHECK_FLOAT_NEAR(result.value, MinimaxValue(*state, 3, evaluator),
+                               1e-9);
+        std::vector<Action> legal = state->LegalActions();
+        SPIEL_CHECK_TRUE(std::find(legal.begin(), legal.end(),
+                                   result.best_action) != legal.end());
+      }
+      std::vector<Action> actions = state->LegalActions();
+      state->ApplyAction(actions[rng() % actions.size()]);
+    }
+  }
+}
+
+}  // namespace
+}  // namespace counter_air
+}  // namespace open_spiel
+
+int main(int argc, char** argv) {
+  open_spiel::counter_air::MatchesMinimaxTest();
+  open_spiel::counter_air::SolvesSmallGameTest();
+  open_spiel::counter_air::ZeroUnitsTest();
+}
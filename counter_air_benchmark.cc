@@ -0,0 +1,336 @@
+// Copyright 2019 DeepMind Technologies Limited
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "open_spiel/games/counter_air_benchmark.h"
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <random>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "absl/strings/str_cat.h"
+#include "absl/strings/str_format.h"
+#include "open_spiel/games/counter_air.h"
+#include "open_spiel/games/counter_air_alpha_beta.h"
+#include "open_spiel/games/counter_air_eval.h"
+#include "open_spiel/spiel.h"
+#include "open_spiel/spiel_utils.h"
+
+namespace open_spiel {
+namespace counter_air {
+namespace {
+
+constexpr int kNumRandomGames = 20000;
+constexpr int kNumCorpusGames = 20;
+constexpr int kCorpusStride = 25;  // Keep every 25th position of a game.
+constexpr int kSearchDepth = 8;
+constexpr int kObservationPasses = 10000;
+
+// Positions of seeded random games; the same on every run and platform.
+std::vector<std::unique_ptr<State>> StateCorpus(const Game &game) {
+    std::vector<std::unique_ptr<State>> corpus;
+    std::mt19937 rng(1);
+    for (int i = 0; i < kNumCorpusGames; i++) {
+        std::unique_ptr<State> state = game.NewInitialState();
+        for (int move = 0; !state->IsTerminal(); move++) {
+            if (move % kCorpusStride == 0) corpus.push_back(state->Clone());
+            std::vector<Action> actions = state->LegalActions();
+            state->ApplyAction(actions[rng() % actions.size()]);
+        }
+    }
+    return corpus;
+}
+
+// Seeded random games through the State API; one op per move.
+int64_t RandomGamesWorkload(const Game &game, uint64_t *checksum) {
+    std::mt19937 rng(0);
+    int64_t ops = 0;
+    for (int i = 0; i < kNumRandomGames; i++) {
+        std::unique_ptr<State> state = game.NewInitialState();
+        while (!state->IsTerminal()) {
+            std::vector<Action> actions = state->LegalActions();
+            state->ApplyAction(actions[rng() % actions.size()]);
+            ops++;
+        }
+        *checksum = *checksum * 31 + static_cast<const CounterAirState &>(*state).StateKey();
+    }
+    return ops;
+}
+
+// Alpha-beta on the corpus; one op per node.
+int64_t SearchWorkload(const std::shared_ptr<const Game> &game,
+                       const std::vector<std::unique_ptr<State>> &corpus,
+                       uint64_t *checksum) {
+    CounterAirAlphaBeta search(game, CounterAirEvaluator());
+    int64_t ops = 0;
+    for (const auto &state : corpus) {
+        const AlphaBetaResult result =
+            search.Search(static_cast<const CounterAirState &>(*state), kSearchDepth);
+        ops += result.nodes;
+        *checksum = *checksum * 31 + result.best_action;
+    }
+    return ops;
+}
+
+// Observation encoding of the corpus; one op per tensor.
+int64_t ObservationWorkload(const std::vector<std::unique_ptr<State>> &corpus,
+                            uint64_t *checksum) {
+    std::vector<float> tensor(kObservationSize);
+    int64_t ops = 0;
+    for (int pass = 0; pass < kObservationPasses; pass++) {
+        for (const auto &state : corpus) {
+            std::fill(tensor.begin(), tensor.end(), 0.0f);
+            state->ObservationTensor(0, absl::MakeSpan(tensor));
+            ops++;
+            if (pass == 0) {
+                for (int i = 0; i < kObservationSize; i++) {
+                    if (tensor[i] != 0) *checksum = *checksum * 31 + i;
+                }
+            }
+        }
+    }
+    return ops;
+}
+
+// The CPU model, for the baseline header.
+std::string HostCpu() {
+    std::string model = "unknown CPU";
+    std::ifstream cpuinfo("/proc/cpuinfo");
+    std::string line;
+    while (std::getline(cpuinfo, line)) {
+        if (line.rfind("model name", 0) == 0 && line.find(':') != std::string::npos) {
+            model = line.substr(line.find(':') + 2);
+            break;
+        }
+    }
+    return model;
+}
+
+}  // namespace
+
+const char *PerfMetricName(PerfMetric metric) {
+    switch (metric) {
+        case kWallNsMetric:
+            return "wall_ns";
+        case kInstructionsMetric:
+            return "instructions";
+        case kCacheMissesMetric:
+            return "cache_misses";
+        case kBranchMissesMetric:
+            return "branch_misses";
+        default:
+            SpielFatalError("Unknown metric");
+    }
+}
+
+PerfCounters::PerfCounters() {
+    fds_.fill(-1);
+#ifdef __linux__
+    constexpr uint64_t kConfigs[kNumPerfMetrics] = {
+        0, PERF_COUNT_HW_INSTRUCTIONS, PERF_COUNT_HW_CACHE_MISSES,
+        PERF_COUNT_HW_BRANCH_MISSES};
+    for (int metric = kInstructionsMetric; metric < kNumPerfMetrics; metric++) {
+        perf_event_attr attr;
+        std::memset(&attr, 0, sizeof(attr));
+        attr.size = sizeof(attr);
+        attr.type = PERF_TYPE_HARDWARE;
+        attr.config = kConfigs[metric];
+        attr.disabled = group_fd_ < 0;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        attr.read_format = PERF_FORMAT_GROUP;
+        const int fd = syscall(__NR_perf_event_open, &attr, 0, -1, group_fd_, 0);
+        if (fd < 0) {
+            // Without a leader there is nothing to group the others under.
+            if (group_fd_ < 0) return;
+            continue;
+        }
+        if (group_fd_ < 0) group_fd_ = fd;
+        fds_[metric] = fd;
+    }
+#endif
+}
+
+PerfCounters::~PerfCounters() {
+#ifdef __linux__
+    for (int fd : fds_) {
+        if (fd >= 0) close(fd);
+    }
+#endif
+}
+
+PerfSample PerfCounters::Measure(const std::function<void()> &fn) {
+    PerfSample sample;
+#ifdef __linux__
+    if (available()) {
+        ioctl(group_fd_, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+        ioctl(group_fd_, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+    }
+#endif
+    const auto start = std::chrono::steady_clock::now();
+    fn();
+    const auto end = std::chrono::steady_clock::now();
+    sample.values[kWallNsMetric] =
+        std::chrono::duration<double, std::nano>(end - start).count();
+#ifdef __linux__
+    if (available()) {
+        ioctl(group_fd_, PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+        // PERF_FORMAT_GROUP: the number of counters, then their values in the
+        // order they were opened.
+        uint64_t buffer[1 + kNumPerfMetrics];
+        if (read(group_fd_, buffer, sizeof(buffer)) > 0) {
+            int index = 1;
+            for (int metric = kInstructionsMetric; metric < kNumPerfMetrics; metric++) {
+                if (fds_[metric] >= 0 && index <= static_cast<int>(buffer[0])) {
+                    sample.values[metric] = buffer[index++];
+                }
+            }
+        }
+    }
+#endif
+    return sample;
+}
+
+double BenchmarkResult::PerOp(PerfMetric metric) const {
+    if (ops == 0 || total.values[metric] < 0) return -1;
+    return total.values[metric] / ops;
+}
+
+std::vector<BenchmarkResult> RunBenchmarks(int repetitions) {
+    SPIEL_CHECK_GE(repetitions, 1);
+    std::shared_ptr<const Game> game = LoadGame("counter_air");
+    const std::vector<std::unique_ptr<State>> corpus = StateCorpus(*game);
+    const std::vector<std::pair<std::string, std::function<int64_t(uint64_t *)>>>
+        workloads = {
+            {"random_games",
+             [&](uint64_t *checksum) { return RandomGamesWorkload(*game, checksum); }},
+            {"search",
+             [&](uint64_t *checksum) { return SearchWorkload(game, corpus, checksum); }},
+            {"observation",
+             [&](uint64_t *checksum) { return ObservationWorkload(corpus, checksum); }},
+        };
+
+    PerfCounters counters;
+    std::vector<BenchmarkResult> results;
+    for (const auto &[name, workload] : workloads) {
+        BenchmarkResult best;
+        best.workload = name;
+        for (int rep = 0; rep < repetitions; rep++) {
+            BenchmarkResult run;
+            run.workload = name;
+            uint64_t checksum = 0;
+            run.total = counters.Measure([&]() { run.ops = workload(&checksum); });
+            run.checksum = static_cast<uint32_t>(checksum ^ (checksum >> 32));
+            if (rep == 0 || run.total.values[kWallNsMetric] <
+                                best.total.values[kWallNsMetric]) {
+                best = run;
+            }
+        }
+        results.push_back(best);
+    }
+    return results;
+}
+
+Baseline ReadBaseline(const std::string &path) {
+    std::ifstream in(path);
+    if (!in) {
+        SpielFatalError(absl::StrCat("Could not open benchmark baseline ", path));
+    }
+    Baseline baseline;
+    std::string line;
+    while (std::getline(in, line)) {
+        if (line.empty() || line[0] == '#') continue;
+        std::istringstream fields(line);
+        std::string key;
+        double value;
+        if (!(fields >> key >> value)) {
+            SpielFatalError(absl::StrCat("Bad benchmark baseline line: ", line));
+        }
+        baseline[key] = value;
+    }
+    return baseline;
+}
+
+void WriteBaseline(const std::string &path, const std::vector<BenchmarkResult> &results) {
+    std::ofstream out(path, std::ios::trunc);
+    out << "# counter_air benchmark baseline, written by counter_air_benchmark\n"
+           "# --update_baseline. Values are per operation.\n";
+    out << "# Host: " << HostCpu() << "\n";
+    if (!results.empty() && results[0].PerOp(kInstructionsMetric) < 0) {
+        out << "# Hardware counters were unavailable; only wall time is recorded.\n";
+    }
+    for (const BenchmarkResult &result : results) {
+        out << absl::StrCat(result.workload, ".checksum ", result.checksum, "\n");
+        out << absl::StrCat(result.workload, ".ops ", result.ops, "\n");
+        for (int metric = 0; metric < kNumPerfMetrics; metric++) {
+            const double per_op = result.PerOp(static_cast<PerfMetric>(metric));
+            if (per_op < 0) continue;
+            out << absl::StrFormat("%s.%s %.4f\n", result.workload,
+                                   PerfMetricName(static_cast<PerfMetric>(metric)),
+                                   per_op);
+        }
+    }
+    if (!out) {
+        SpielFatalError(absl::StrCat("Could not write benchmark baseline ", path));
+    }
+}
+
+std::vector<std::string> CompareToBaseline(const std::vector<BenchmarkResult> &results,
+                                           const Baseline &baseline,
+                                           const RegressionThresholds &thresholds) {
+    std::vector<std::string> failures;
+    for (const BenchmarkResult &result : results) {
+        auto checksum = baseline.find(result.workload + ".checksum");
+        if (checksum != baseline.end() && checksum->second != result.checksum) {
+            failures.push_back(absl::StrCat(
+                result.workload,
+                ": checksum differs from the baseline; the workload or the rules "
+                "changed, so the baseline must be updated"));
+            continue;
+        }
+        for (int metric = 0; metric < kNumPerfMetrics; metric++) {
+            if (metric == kWallNsMetric && !thresholds.compare_wall_time) continue;
+            const double current = result.PerOp(static_cast<PerfMetric>(metric));
+            const std::string key = absl::StrCat(
+                result.workload, ".", PerfMetricName(static_cast<PerfMetric>(metric)));
+            auto it = baseline.find(key);
+            if (current < 0 || it == baseline.end() || it->second <= 0) continue;
+            const double growth = current / it->second - 1;
+            if (growth > thresholds.max_growth[metric]) {
+                failures.push_back(absl::StrFormat(
+                    "%s: %.4f per op against a baseline of %.4f (+%.1f%%, allowed "
+                    "+%.1f%%)",
+                    key, current, it->second, 100 * growth,
+                    100 * thresholds.max_growth[metric]));
+            }
+        }
+    }
+    return failures;
+}
+
+}  // namespace counter_air
+}  // namespace open_spiel
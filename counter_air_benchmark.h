@@ -0,0 +1,109 @@
+// Copyright 2019 DeepMind Technologies Limited
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef OPEN_SPIEL_GAMES_COUNTER_AIR_BENCHMARK_H_
+#define OPEN_SPIEL_GAMES_COUNTER_AIR_BENCHMARK_H_
+
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <string>
+#include <vector>
+
+// Performance-regression suite for counter_air. A few fixed, seeded
+// workloads are timed and, where the kernel allows perf_event_open, measured
+// with hardware counters. Results are normalised per operation and compared
+// with a baseline file; a metric that grows by more than its threshold is a
+// regression. Each workload also produces a checksum, so a baseline is only
+// compared against the workload it was recorded from.
+//
+// Baseline format: one "<workload>.<metric> <value>" pair per line; lines
+// starting with '#' are comments. WriteBaseline() notes the recording host's
+// CPU in a comment.
+
+namespace open_spiel {
+namespace counter_air {
+
+enum PerfMetric {
+    kWallNsMetric,
+    kInstructionsMetric,
+    kCacheMissesMetric,
+    kBranchMissesMetric,
+    kNumPerfMetrics,
+};
+
+const char *PerfMetricName(PerfMetric metric);
+
+// Totals over a measured interval; counters that could not be read are -1.
+struct PerfSample {
+    std::array<double, kNumPerfMetrics> values = {0, -1, -1, -1};
+};
+
+// Hardware counters of the calling thread, or only the wall clock when
+// perf_event_open is not available.
+class PerfCounters {
+   public:
+    PerfCounters();
+    ~PerfCounters();
+    PerfCounters(const PerfCounters &) = delete;
+    PerfCounters &operator=(const PerfCounters &) = delete;
+
+    bool available() const { return group_fd_ >= 0; }
+    // Measures `fn`.
+    PerfSample Measure(const std::function<void()> &fn);
+
+   private:
+    int group_fd_ = -1;
+    std::array<int, kNumPerfMetrics> fds_;
+};
+
+struct BenchmarkResult {
+    std::string workload;
+    int64_t ops = 0;
+    // 32 bits, so that the baseline holds it exactly as a double.
+    uint32_t checksum = 0;
+    PerfSample total;  // Of the fastest repetition.
+
+    // -1 if the metric was not measured.
+    double PerOp(PerfMetric metric) const;
+};
+
+// Runs every workload `repetitions` times and keeps the fastest run.
+std::vector<BenchmarkResult> RunBenchmarks(int repetitions);
+
+using Baseline = std::map<std::string, double>;
+
+Baseline ReadBaseline(const std::string &path);
+void WriteBaseline(const std::string &path, const std::vector<BenchmarkResult> &results);
+
+// Allowed growth of each metric, as a fraction of the baseline.
+struct RegressionThresholds {
+    std::array<double, kNumPerfMetrics> max_growth = {0.15, 0.02, 0.25, 0.10};
+    // Wall time only carries over between runs on the host that recorded the
+    // baseline, so by default it is reported but not compared.
+    bool compare_wall_time = false;
+};
+
+// Returns one message per regression or mismatched workload; empty if the
+// results are within the thresholds. Metrics missing on either side are
+// skipped.
+std::vector<std::string> CompareToBaseline(const std::vector<BenchmarkResult> &results,
+                                           const Baseline &baseline,
+                                           const RegressionThresholds &thresholds);
+
+}  // namespace counter_air
+}  // namespace open_spiel
+
+#endif  // OPEN_SPIEL_GAMES_COUNTER_AIR_BENCHMARK_H_
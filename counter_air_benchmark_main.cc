@@ -0,0 +1,88 @@
+// Copyright 2019 DeepMind Technologies Limited
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Runs the counter_air benchmarks and compares them with the baseline file.
+// Exits with status 1 on a regression.
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "absl/flags/flag.h"
+#include "absl/flags/parse.h"
+#include "absl/strings/str_format.h"
+#include "open_spiel/games/counter_air_benchmark.h"
+
+ABSL_FLAG(std::string, baseline, "counter_air_benchmark_baseline.txt",
+          "Baseline file to compare with.");
+ABSL_FLAG(bool, update_baseline, false,
+          "Write the results to the baseline file instead of comparing.");
+ABSL_FLAG(int, repetitions, 5, "Runs of each workload; the fastest is kept.");
+ABSL_FLAG(bool, compare_wall_time, false,
+          "Also compare wall time; only meaningful on the baseline's host.");
+ABSL_FLAG(double, max_wall_growth, 0.15,
+          "Allowed growth of wall time per op, with --compare_wall_time.");
+ABSL_FLAG(double, max_instructions_growth, 0.02,
+          "Allowed growth of instructions per op.");
+ABSL_FLAG(double, max_cache_misses_growth, 0.25,
+          "Allowed growth of cache misses per op.");
+ABSL_FLAG(double, max_branch_misses_growth, 0.10,
+          "Allowed growth of branch misses per op.");
+
+int main(int argc, char** argv) {
+    absl::ParseCommandLine(argc, argv);
+    namespace ca = open_spiel::counter_air;
+
+    {
+        ca::PerfCounters counters;
+        if (!counters.available()) {
+            std::cout << "Hardware counters unavailable; only checksums"
+                      << (absl::GetFlag(FLAGS_compare_wall_time) ? " and wall time" : "")
+                      << " are compared.\n";
+        }
+    }
+    const std::vector<ca::BenchmarkResult> results =
+        ca::RunBenchmarks(absl::GetFlag(FLAGS_repetitions));
+    for (const ca::BenchmarkResult &result : results) {
+        std::cout << absl::StrFormat("%-14s %10d ops", result.workload, result.ops);
+        for (int metric = 0; metric < ca::kNumPerfMetrics; metric++) {
+            const double per_op = result.PerOp(static_cast<ca::PerfMetric>(metric));
+            if (per_op < 0) continue;
+            std::cout << absl::StrFormat(
+                "  %s/op %.2f", ca::PerfMetricName(static_cast<ca::PerfMetric>(metric)),
+                per_op);
+        }
+        std::cout << "\n";
+    }
+
+    if (absl::GetFlag(FLAGS_update_baseline)) {
+        ca::WriteBaseline(absl::GetFlag(FLAGS_baseline), results);
+        std::cout << "Wrote " << absl::GetFlag(FLAGS_baseline) << "\n";
+        return 0;
+    }
+    ca::RegressionThresholds thresholds;
+    thresholds.max_growth = {absl::GetFlag(FLAGS_max_wall_growth),
+                             absl::GetFlag(FLAGS_max_instructions_growth),
+                             absl::GetFlag(FLAGS_max_cache_misses_growth),
+                             absl::GetFlag(FLAGS_max_branch_misses_growth)};
+    thresholds.compare_wall_time = absl::GetFlag(FLAGS_compare_wall_time);
+    const std::vector<std::string> failures = ca::CompareToBaseline(
+        results, ca::ReadBaseline(absl::GetFlag(FLAGS_baseline)), thresholds);
+    for (const std::string &failure : failures) {
+        std::cout << "REGRESSION " << failure << "\n";
+    }
+    if (!failures.empty()) return 1;
+    std::cout << "No regressions.\n";
+    return 0;
+}
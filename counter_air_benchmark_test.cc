@@ -0,0 +1,106 @@
+// Copyright 2019 DeepMind Technologies Limited
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "open_spiel/games/counter_air_benchmark.h"
+
+#include <unistd.h>
+
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#include "open_spiel/spiel_utils.h"
+
+namespace open_spiel {
+namespace counter_air {
+namespace {
+
+BenchmarkResult MakeResult(double wall_ns, double instructions) {
+  BenchmarkResult result;
+  result.workload = "random_games";
+  result.ops = 100;
+  result.checksum = 1234;
+  result.total.values[kWallNsMetric] = wall_ns;
+  result.total.values[kInstructionsMetric] = instructions;
+  return result;
+}
+
+void PerfCountersTest() {
+  PerfCounters counters;
+  volatile int sink = 0;
+  PerfSample sample = counters.Measure([&sink]() {
+    for (int i = 0; i < 100000; i++) sink = sink + i;
+  });
+  SPIEL_CHECK_GT(sample.values[kWallNsMetric], 0);
+  if (counters.available()) {
+    SPIEL_CHECK_GT(sample.values[kInstructionsMetric], 100000);
+  } else {
+    SPIEL_CHECK_EQ(sample.values[kInstructionsMetric], -1);
+  }
+}
+
+void BaselineRoundTripTest() {
+  char path[] = "/tmp/counter_air_benchmark_test.XXXXXX";
+  const int fd = mkstemp(path);
+  SPIEL_CHECK_GE(fd, 0);
+  close(fd);
+  WriteBaseline(path, {MakeResult(10000, -1)});
+  Baseline baseline = ReadBaseline(path);
+  SPIEL_CHECK_EQ(unlink(path), 0);
+  SPIEL_CHECK_EQ(baseline["random_games.checksum"], 1234);
+  SPIEL_CHECK_EQ(baseline["random_games.ops"], 100);
+  SPIEL_CHECK_FLOAT_NEAR(baseline["random_games.wall_ns"], 100, 1e-9);
+  // Unmeasured counters are left out.
+  SPIEL_CHECK_TRUE(baseline.find("random_games.instructions") == baseline.end());
+}
+
+void CompareTest() {
+  const Baseline baseline = {{"random_games.checksum", 1234},
+                             {"random_games.wall_ns", 100},
+                             {"random_games.instructions", 1000}};
+  RegressionThresholds thresholds;
+  // Wall time alone is not compared by default.
+  SPIEL_CHECK_TRUE(
+      CompareToBaseline({MakeResult(12000, 100000)}, baseline, thresholds).empty());
+  thresholds.compare_wall_time = true;
+  // Within the thresholds, or faster.
+  SPIEL_CHECK_TRUE(
+      CompareToBaseline({MakeResult(11000, 100500)}, baseline, thresholds).empty());
+  SPIEL_CHECK_TRUE(
+      CompareToBaseline({MakeResult(5000, 50000)}, baseline, thresholds).empty());
+  // Too slow, and too many instructions.
+  SPIEL_CHECK_EQ(
+      CompareToBaseline({MakeResult(12000, 100000)}, baseline, thresholds).size(), 1);
+  SPIEL_CHECK_EQ(
+      CompareToBaseline({MakeResult(12000, 110000)}, baseline, thresholds).size(), 2);
+  // Counters that were not measured are not compared.
+  SPIEL_CHECK_TRUE(
+      CompareToBaseline({MakeResult(10000, -1)}, baseline, thresholds).empty());
+  // A different workload is reported instead of compared.
+  BenchmarkResult other = MakeResult(10000, 100000);
+  other.checksum = 99;
+  std::vector<std::string> failures = CompareToBaseline({other}, baseline, thresholds);
+  SPIEL_CHECK_EQ(failures.size(), 1);
+  SPIEL_CHECK_NE(failures[0].find("checksum"), std::string::npos);
+}
+
+}  // namespace
+}  // namespace counter_air
+}  // namespace open_spiel
+
+int main(int argc, char** argv) {
+  open_spiel::counter_air::PerfCountersTest();
+  open_spiel::counter_air::BaselineRoundTripTest();
+  open_spiel::counter_air::CompareTest();
+}
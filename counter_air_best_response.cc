@@ -0,0 +1,210 @@
+// Copyright 2019 DeepMind Technologies Limited
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "open_spiel/games/counter_air_best_response.h"
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "absl/container/flat_hash_set.h"
+#include "open_spiel/games/counter_air_rules.h"
+#include "open_spiel/spiel_utils.h"
+
+namespace open_spiel {
+namespace counter_air {
+namespace {
+
+// The frontier solved in parallel holds at least this many states per thread,
+// unless the game ends first.
+constexpr int kFrontierStatesPerThread = 16;
+
+const RuleTable &RulesOf(const Game &game) {
+    return static_cast<const CounterAirGame &>(game).rules();
+}
+
+// Returns of a terminal state, as in CounterAirState::Returns().
+double TerminalValue(const CompactState &state, Player player) {
+    if (state.outcome == 0) return player == 0 ? 1 : -1;
+    if (state.outcome == 1) return player == 0 ? -1 : 1;
+    return 0;
+}
+
+ActionsAndProbs UniformOver(uint16_t legal_mask) {
+    ActionsAndProbs policy;
+    for (Action action = 0; action < kNumDistinctActions; action++) {
+        if (legal_mask & (1 << action)) policy.push_back({action, 0.0});
+    }
+    for (auto &[action, prob] : policy) prob = 1.0 / policy.size();
+    return policy;
+}
+
+}  // namespace
+
+CompactPolicy UniformCompactPolicy(const Game &game) {
+    const RuleTable &rules = RulesOf(game);
+    return [&rules](const CompactState &state) {
+        return UniformOver(RuleLegalMask(rules, state));
+    };
+}
+
+CompactPolicy TabularCompactPolicy(const Game &game,
+                                   std::shared_ptr<const CompactPolicyTable> table) {
+    const RuleTable &rules = RulesOf(game);
+    return [&rules, table](const CompactState &state) {
+        auto it = table->find(CompactStateKey(state));
+        if (it != table->end()) return it->second;
+        return UniformOver(RuleLegalMask(rules, state));
+    };
+}
+
+CounterAirBestResponse::CounterAirBestResponse(std::shared_ptr<const Game> game,
+                                               Player best_responder,
+                                               CompactPolicy policy,
+                                               int num_threads)
+    : game_(game),
+      rules_(RulesOf(*game)),
+      best_responder_(best_responder),
+      policy_(std::move(policy)),
+      num_threads_(num_threads > 0
+                       ? num_threads
+                       : std::max<int>(1, std::thread::hardware_concurrency())) {
+    SPIEL_CHECK_GE(best_responder, 0);
+    SPIEL_CHECK_LT(best_responder, game->NumPlayers());
+}
+
+bool CounterAirBestResponse::Lookup(uint64_t key, Node *node) {
+    Shard &shard = shards_[key % kNumShards];
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    auto it = shard.nodes.find(key);
+    if (it == shard.nodes.end()) return false;
+    *node = it->second;
+    return true;
+}
+
+void CounterAirBestResponse::Insert(uint64_t key, const Node &node) {
+    Shard &shard = shards_[key % kNumShards];
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    shard.nodes.emplace(key, node);
+}
+
+CounterAirBestResponse::Node CounterAirBestResponse::Solve(
+    const CompactState &state) {
+    const uint16_t legal = RuleLegalMask(rules_, state);
+    if (legal == 0) {
+        return {TerminalValue(state, best_responder_), kInvalidAction};
+    }
+    const uint64_t key = CompactStateKey(state);
+    Node node;
+    if (Lookup(key, &node)) return node;
+
+    if (state.current_player == best_responder_) {
+        node = {0.0, kInvalidAction};
+        for (Action action = 0; action < kNumDistinctActions; action++) {
+            if (!(legal & (1 << action))) continue;
+            CompactState child = state;
+            RuleApplyAction(rules_, &child, action);
+            const double value = Solve(child).value;
+            if (node.best_action == kInvalidAction || value > node.value) {
+                node = {value, action};
+            }
+        }
+    } else {
+        node = {0.0, kInvalidAction};
+        for (const auto &[action, prob] : policy_(state)) {
+            if (prob == 0) continue;
+            SPIEL_DCHECK_TRUE(legal & (1 << action));
+            CompactState child = state;
+            RuleApplyAction(rules_, &child, action);
+            node.value += prob * Solve(child).value;
+        }
+    }
+    Insert(key, node);
+    return node;
+}
+
+void CounterAirBestResponse::SolveFrontier(const CompactState &root) {
+    if (num_threads_ == 1) return;
+    // Breadth-first expansion until the frontier is wide enough.
+    std::vector<CompactState> frontier = {root};
+    const size_t target = static_cast<size_t>(num_threads_) * kFrontierStatesPerThread;
+    while (!frontier.empty() && frontier.size() < target) {
+        std::vector<CompactState> next;
+        absl::flat_hash_set<uint64_t> seen;
+        for (const CompactState &state : frontier) {
+            const uint16_t legal = RuleLegalMask(rules_, state);
+            for (Action action = 0; action < kNumDistinctActions; action++) {
+                if (!(legal & (1 << action))) continue;
+                CompactState child = state;
+                RuleApplyAction(rules_, &child, action);
+                if (seen.insert(CompactStateKey(child)).second) {
+                    next.push_back(child);
+                }
+            }
+        }
+        frontier = std::move(next);
+    }
+
+    std::atomic<size_t> next_index{0};
+    auto worker = [&]() {
+        for (size_t i = next_index++; i < frontier.size(); i = next_index++) {
+            Solve(frontier[i]);
+        }
+    };
+    std::vector<std::thread> threads;
+    for (int t = 1; t < num_threads_; t++) threads.emplace_back(worker);
+    worker();
+    for (std::thread &thread : threads) thread.join();
+}
+
+double CounterAirBestResponse::Value() {
+    std::unique_ptr<State> state = game_->NewInitialState();
+    return Value(static_cast<const CounterAirState &>(*state));
+}
+
+double CounterAirBestResponse::Value(const CounterAirState &state) {
+    const CompactState compact = state.ToCompact();
+    Node node;
+    if (!Lookup(CompactStateKey(compact), &node)) SolveFrontier(compact);
+    return Solve(compact).value;
+}
+
+Action CounterAirBestResponse::BestAction(const CounterAirState &state) {
+    SPIEL_CHECK_EQ(state.CurrentPlayer(), best_responder_);
+    const CompactState compact = state.ToCompact();
+    Node node;
+    if (!Lookup(CompactStateKey(compact), &node)) SolveFrontier(compact);
+    return Solve(compact).best_action;
+}
+
+int CounterAirBestResponse::num_states() const {
+    int num_states = 0;
+    for (const Shard &shard : shards_) num_states += shard.nodes.size();
+    return num_states;
+}
+
+double CounterAirExploitability(std::shared_ptr<const Game> game,
+                                const CompactPolicy &policy, int num_threads) {
+    double total = 0;
+    for (Player player = 0; player < game->NumPlayers(); player++) {
+        CounterAirBestResponse best_response(game, player, policy, num_threads);
+        total += best_response.Value();
+    }
+    return total / game->NumPlayers();
+}
+
+}  // namespace counter_air
+}  // namespace open_spiel
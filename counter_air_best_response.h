@@ -0,0 +1,96 @@
+// Copyright 2019 DeepMind Technologies Limited
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef OPEN_SPIEL_GAMES_COUNTER_AIR_BEST_RESPONSE_H_
+#define OPEN_SPIEL_GAMES_COUNTER_AIR_BEST_RESPONSE_H_
+
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+
+#include "absl/container/flat_hash_map.h"
+#include "open_spiel/games/counter_air.h"
+#include "open_spiel/spiel.h"
+
+// Exact best responses in counter_air. The game has perfect information, so
+// the best response to a fixed policy is an expectimax over the game tree:
+// the responder takes the best child and the policy player averages its
+// children under the policy. Values are memoised on CompactStateKey(), which
+// merges transpositions that history-keyed traversals treat separately, and
+// the subtrees below the root are solved on several threads sharing the memo.
+
+namespace open_spiel {
+namespace counter_air {
+
+// The policy of the player to move in `state`; must be thread-safe. Actions
+// with probability 0 are not explored.
+using CompactPolicy = std::function<ActionsAndProbs(const CompactState &state)>;
+
+// Policy given as a table keyed on CompactStateKey(); states that are not in
+// the table are played uniformly at random.
+using CompactPolicyTable = absl::flat_hash_map<uint64_t, ActionsAndProbs>;
+CompactPolicy TabularCompactPolicy(const Game &game,
+                                   std::shared_ptr<const CompactPolicyTable> table);
+CompactPolicy UniformCompactPolicy(const Game &game);
+
+class CounterAirBestResponse {
+   public:
+    // num_threads == 0 uses all hardware threads.
+    CounterAirBestResponse(std::shared_ptr<const Game> game, Player best_responder,
+                           CompactPolicy policy, int num_threads = 0);
+
+    // Expected return of the best responder from the initial state.
+    double Value();
+    double Value(const CounterAirState &state);
+    // The best responder must be to move.
+    Action BestAction(const CounterAirState &state);
+
+    int num_states() const;
+
+   private:
+    struct Node {
+        double value;
+        Action best_action;
+    };
+    struct Shard {
+        std::mutex mutex;
+        absl::flat_hash_map<uint64_t, Node> nodes;
+    };
+    inline static constexpr int kNumShards = 64;
+
+    Node Solve(const CompactState &state);
+    // Solves the states a few plies below `root` in parallel.
+    void SolveFrontier(const CompactState &root);
+    bool Lookup(uint64_t key, Node *node);
+    void Insert(uint64_t key, const Node &node);
+
+    std::shared_ptr<const Game> game_;
+    const RuleTable &rules_;
+    Player best_responder_;
+    CompactPolicy policy_;
+    int num_threads_;
+    std::array<Shard, kNumShards> shards_;
+};
+
+// Mean over both players of the best response value against `policy`, which
+// must cover both players. Zero exactly for a Nash equilibrium.
+double CounterAirExploitability(std::shared_ptr<const Game> game,
+                                const CompactPolicy &policy, int num_threads = 0);
+
+}  // namespace counter_air
+}  // namespace open_spiel
+
+#endif  // OPEN_SPIEL_GAMES_COUNTER_AIR_BEST_RESPONSE_H_
@@ -0,0 +1,132 @@
+// Copyright 2019 DeepMind Technologies Limited
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "open_spiel/games/counter_air_best_response.h"
+
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+#include "open_spiel/games/counter_air.h"
+#include "open_spiel/games/counter_air_solve_job.h"
+#include "open_spiel/spiel.h"
+#include "open_spiel/spiel_utils.h"
+
+namespace open_spiel {
+namespace counter_air {
+namespace {
+
+std::shared_ptr<const Game> SmallGame(int blue_fighters, int red_fighters,
+                                      int hit_threshold) {
+  return LoadGame("counter_air",
+                  {{"blue_fighters", GameParameter(blue_fighters)},
+                   {"red_fighters", GameParameter(red_fighters)},
+                   {"red_sams", GameParameter(1)},
+                   {"num_waves", GameParameter(1)},
+                   {"num_aaa", GameParameter(1)},
+                   {"hit_threshold", GameParameter(hit_threshold)}});
+}
+
+// Plain expectimax over State objects, without memoisation.
+double ReferenceValue(const State& state, Player responder) {
+  if (state.IsTerminal()) return state.Returns()[responder];
+  std::vector<Action> actions = state.LegalActions();
+  std::vector<double> values;
+  for (Action action : actions) {
+    values.push_back(ReferenceValue(*state.Child(action), responder));
+  }
+  if (state.CurrentPlayer() == responder) {
+    return *std::max_element(values.begin(), values.end());
+  }
+  double value = 0;
+  for (double child_value : values) value += child_value / values.size();
+  return value;
+}
+
+void MatchesReferenceTest() {
+  std::shared_ptr<const Game> game = SmallGame(1, 1, 1);
+  std::unique_ptr<State> state = game->NewInitialState();
+  for (Player responder : {0, 1}) {
+    CounterAirBestResponse best_response(game, responder,
+                                         UniformCompactPolicy(*game), 1);
+    SPIEL_CHECK_FLOAT_NEAR(best_response.Value(),
+                           ReferenceValue(*state, responder), 1e-9);
+  }
+}
+
+void ParallelTest() {
+  std::shared_ptr<const Game> game = SmallGame(4, 2, 2);
+  CounterAirBestResponse serial(game, 0, UniformCompactPolicy(*game), 1);
+  CounterAirBestResponse parallel(game, 0, UniformCompactPolicy(*game), 4);
+  SPIEL_CHECK_FLOAT_NEAR(serial.Value(), parallel.Value(), 1e-9);
+  SPIEL_CHECK_EQ(serial.num_states(), parallel.num_states());
+}
+
+void ExploitabilityTest() {
+  std::shared_ptr<const Game> game = SmallGame(1, 1, 1);
+  std::unique_ptr<State> state = game->NewInitialState();
+  const double uniform =
+      CounterAirExploitability(game, UniformCompactPolicy(*game), 1);
+  SPIEL_CHECK_GE(uniform, 0);
+  SPIEL_CHECK_FLOAT_NEAR(
+      uniform,
+      (ReferenceValue(*state, 0) + ReferenceValue(*state, 1)) / 2, 1e-9);
+}
+
+void MinimaxTest() {
+  std::shared_ptr<const Game> game = SmallGame(2, 1, 2);
+  CounterAirSolveJob job(game, SolveJobOptions());
+  SPIEL_CHECK_TRUE(job.Run());
+
+  // Both players play the solve's minimax actions in every reachable state.
+  auto table = std::make_shared<CompactPolicyTable>();
+  std::vector<std::unique_ptr<State>> stack;
+  stack.push_back(game->NewInitialState());
+  while (!stack.empty()) {
+    std::unique_ptr<State> current = std::move(stack.back());
+    stack.pop_back();
+    if (current->IsTerminal()) continue;
+    const auto& counter_air = static_cast<const CounterAirState&>(*current);
+    if (!table->emplace(counter_air.StateKey(),
+                        ActionsAndProbs{{job.BestAction(counter_air), 1.0}})
+             .second) {
+      continue;
+    }
+    for (Action action : current->LegalActions()) {
+      stack.push_back(current->Child(action));
+    }
+  }
+  const CompactPolicy minimax = TabularCompactPolicy(*game, table);
+
+  std::unique_ptr<State> state = game->NewInitialState();
+  const int value = job.Value(static_cast<const CounterAirState&>(*state));
+  CounterAirBestResponse blue(game, 0, minimax, 1);
+  CounterAirBestResponse red(game, 1, minimax, 1);
+  SPIEL_CHECK_FLOAT_NEAR(blue.Value(), value, 1e-9);
+  SPIEL_CHECK_FLOAT_NEAR(red.Value(), -value, 1e-9);
+  const double exploitability = CounterAirExploitability(game, minimax, 1);
+  SPIEL_CHECK_GE(exploitability, -1e-9);
+  SPIEL_CHECK_FLOAT_NEAR(exploitability, 0, 1e-9);
+}
+
+}  // namespace
+}  // namespace counter_air
+}  // namespace open_spiel
+
+int main(int argc, char** argv) {
+  open_spiel::counter_air::MatchesReferenceTest();
+  open_spiel::counter_air::ParallelTest();
+  open_spiel::counter_air::ExploitabilityTest();
+  open_spiel::counter_air::MinimaxTest();
+}
@@ -0,0 +1,268 @@
+// Copyright 2019 DeepMind Technologies Limited
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "open_spiel/games/counter_air_combat.h"
+
+#include <algorithm>
+#include <array>
+#include <vector>
+
+#include "open_spiel/spiel_utils.h"
+
+namespace open_spiel {
+namespace counter_air {
+namespace {
+
+constexpr int kCombatPhase = 5;
+constexpr int kNumCombatCells = 10;  // board_[0..9]
+
+// The part of a state that phase 5 depends on.
+struct CombatPosition {
+    std::array<int, kNumCombatCells> board;
+    int blue_hits;
+    int red_hits;
+    int attacking_box;
+    int player;
+    bool is_attacking;
+};
+
+CombatPosition ToPosition(const CounterAirState &state) {
+    CombatPosition pos;
+    std::copy(state.board_.begin(), state.board_.begin() + kNumCombatCells,
+              pos.board.begin());
+    pos.blue_hits = state.blue_hits_;
+    pos.red_hits = state.red_hits_;
+    pos.attacking_box = state.attacking_box_;
+    pos.player = state.current_player_;
+    pos.is_attacking = state.is_attacking_;
+    return pos;
+}
+
+// The SEAD box is not used in phase 5 and attacking_box_ is only read while
+// defending, so both are left out of the key.
+uint64_t PositionKey(const CombatPosition &pos) {
+    uint64_t key = 0;
+    for (int i : {0, 1, 2, 3, 6, 7, 8, 9}) {
+        key = (key << 4) | pos.board[i];
+    }
+    key = (key << 3) | pos.blue_hits;
+    key = (key << 2) | pos.red_hits;
+    key = (key << 5) | (pos.is_attacking ? 0 : pos.attacking_box);
+    key = (key << 1) | pos.player;
+    key = (key << 1) | pos.is_attacking;
+    return key;
+}
+
+// Mirrors the phase 5 branch of CounterAirState::LegalActions().
+int CombatLegalActions(const CombatPosition &pos, std::array<Action, 4> *moves) {
+    const auto &b = pos.board;
+    int n = 0;
+    if (pos.player == 0) {
+        if (pos.is_attacking) {
+            if (b[0] > 0 && b[8] > 0) (*moves)[n++] = 1;
+        } else {
+            (*moves)[n++] = 0;
+            if (b[0] > 0) (*moves)[n++] = 1;
+            if (pos.attacking_box == 2) (*moves)[n++] = 2;
+            if (pos.attacking_box == 6) (*moves)[n++] = 3;
+        }
+    } else {
+        if (pos.is_attacking) {
+            if (b[8] > 0 && b[0] > 0) (*moves)[n++] = 0;
+            if (b[8] > 0 && b[2] > 0) (*moves)[n++] = 1;
+            if (b[8] > 0 && b[6] > 0) (*moves)[n++] = 2;
+        } else {
+            (*moves)[n++] = 0;
+            (*moves)[n++] = 1;
+        }
+    }
+    if (n == 0) {
+        const bool no_targets = b[0] == 0 && b[2] == 0 && b[6] == 0;
+        (*moves)[n++] = (b[8] == 0 || no_targets) ? 12 : 11;
+    }
+    return n;
+}
+
+// Mirrors the phase 5 branch of CounterAirState::DoApplyAction() and returns
+// the net damage dealt by Blue on this step. Must not be called with move 12.
+int CombatStep(CombatPosition *pos, Action move, int threshold) {
+    auto &b = pos->board;
+    int damage = 0;
+    if (move == 11) {
+        pos->player = 1 - pos->player;
+        pos->is_attacking = true;
+        return damage;
+    }
+    if (pos->player == 0) {
+        if (pos->is_attacking) {
+            pos->attacking_box = 8;
+            b[0]--;
+            b[1]++;
+            pos->is_attacking = false;
+            pos->player = 1;
+        } else {
+            const int box = pos->attacking_box;
+            if (move == 0) {
+                pos->blue_hits += 2;
+                damage -= 2;
+                if (pos->blue_hits > threshold) {
+                    pos->blue_hits -= threshold;
+                    b[box]--;
+                }
+            } else if (move == 1) {
+                b[0]--;
+                b[1]++;
+                pos->blue_hits++;
+                damage--;
+                if (pos->blue_hits >= threshold) {
+                    pos->blue_hits -= threshold;
+                    if (b[box] > 0) {
+                        b[box]--;
+                    } else {
+                        b[box + 1]--;
+                    }
+                }
+            } else {
+                pos->blue_hits++;
+                damage--;
+                b[box]--;
+                if (pos->blue_hits >= threshold) {
+                    pos->blue_hits -= threshold;
+                } else {
+                    b[box + 1]++;
+                }
+            }
+            pos->is_attacking = true;
+        }
+    } else {
+        if (pos->is_attacking) {
+            static constexpr int kTargetBox[] = {0, 2, 6};
+            pos->attacking_box = kTargetBox[move];
+            pos->is_attacking = false;
+            b[8]--;
+            b[9]++;
+            pos->player = 0;
+        } else {
+            if (move == 1) {
+                pos->red_hits++;
+                damage++;
+                b[8]--;
+                if (pos->red_hits >= threshold) {
+                    pos->red_hits -= threshold;
+                } else {
+                    b[9]++;
+                }
+            } else {
+                pos->red_hits += 2;
+                damage += 2;
+                if (pos->red_hits >= threshold) {
+                    pos->red_hits -= threshold;
+                    b[8]--;
+                }
+            }
+            pos->is_attacking = true;
+        }
+    }
+    return damage;
+}
+
+CombatEntry SolvePosition(const CombatPosition &pos, int threshold,
+                          absl::flat_hash_map<uint64_t, CombatEntry> *table) {
+    const uint64_t key = PositionKey(pos);
+    auto it = table->find(key);
+    if (it != table->end()) return it->second;
+
+    std::array<Action, 4> moves;
+    const int num_moves = CombatLegalActions(pos, &moves);
+    CombatEntry entry{0, static_cast<int8_t>(moves[0])};
+    if (moves[0] != 12) {
+        const bool maximising = pos.player == 0;
+        int best_value = 0;
+        for (int i = 0; i < num_moves; i++) {
+            CombatPosition child = pos;
+            int value = CombatStep(&child, moves[i], threshold);
+            value += SolvePosition(child, threshold, table).value;
+            if (i == 0 || (maximising ? value > best_value : value < best_value)) {
+                best_value = value;
+                entry.best_action = moves[i];
+            }
+        }
+        entry.value = best_value;
+    }
+    return table->emplace(key, entry).first->second;
+}
+
+}  // namespace
+
+void CombatSolver::SolveAllEntries() {
+    // Phase 5 starts with Blue to attack, all fighters attacking, and the
+    // Blue fighters spread over the escort, high and low strike boxes. The
+    // strict check of an undefended hit lets Blue end a turn on the threshold.
+    const int fighters = config_.blue_fighters;
+    const int threshold = config_.hit_threshold;
+    CombatPosition pos{};
+    pos.player = 0;
+    pos.is_attacking = true;
+    for (int escort = 0; escort <= fighters; escort++) {
+        for (int high = 0; escort + high <= fighters; high++) {
+            for (int low = 0; escort + high + low <= fighters; low++) {
+                for (int intercept = 0; intercept <= config_.red_fighters; intercept++) {
+                    for (int blue_hits = 0; blue_hits <= threshold; blue_hits++) {
+                        for (int red_hits = 0; red_hits < threshold; red_hits++) {
+                            pos.board = {escort, 0, high, 0, 0, 0, low, 0, intercept, 0};
+                            pos.blue_hits = blue_hits;
+                            pos.red_hits = red_hits;
+                            SolvePosition(pos, threshold, &table_);
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
+
+CombatEntry CombatSolver::Solve(const CounterAirState &state) {
+    SPIEL_CHECK_EQ(state.current_phase_, kCombatPhase);
+    SPIEL_CHECK_FALSE(state.IsTerminal());
+    return SolvePosition(ToPosition(state), config_.hit_threshold, &table_);
+}
+
+int CombatSolver::Value(const CounterAirState &state) {
+    return Solve(state).value;
+}
+
+Action CombatSolver::BestAction(const CounterAirState &state) {
+    return Solve(state).best_action;
+}
+
+std::vector<Action> CombatSolver::BestLine(const CounterAirState &state) {
+    std::vector<Action> line;
+    CombatPosition pos = ToPosition(state);
+    while (true) {
+        Action action =
+            SolvePosition(pos, config_.hit_threshold, &table_).best_action;
+        line.push_back(action);
+        if (action == 12) return line;
+        CombatStep(&pos, action, config_.hit_threshold);
+    }
+}
+
+void CombatSolver::Resolve(CounterAirState *state) {
+    for (Action action : BestLine(*state)) {
+        state->ApplyAction(action);
+    }
+}
+
+}  // namespace counter_air
+}  // namespace open_spiel
@@ -0,0 +1,72 @@
+// Copyright 2019 DeepMind Technologies Limited
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef OPEN_SPIEL_GAMES_COUNTER_AIR_COMBAT_H_
+#define OPEN_SPIEL_GAMES_COUNTER_AIR_COMBAT_H_
+
+#include <cstdint>
+#include <vector>
+
+#include "absl/container/flat_hash_map.h"
+#include "open_spiel/games/counter_air.h"
+#include "open_spiel/spiel.h"
+
+// Solver for the fighter-fighter combat of phase 5, treated as a subgame of
+// its own. Phase 5 only reads and writes board_[0..9] (minus the SEAD box),
+// the hit counters, attacking_box_, is_attacking_ and the current player, so
+// its positions are keyed on those alone and shared between waves.
+//
+// The value of a position is the net damage, in hits, that Blue deals until
+// the phase ends: every point scored counts as the game's hit threshold in
+// hits, plus the change of the opponent's hit counter, minus the same
+// quantities for Red. Blue maximises
+// and Red minimises it.
+
+namespace open_spiel {
+namespace counter_air {
+
+struct CombatEntry {
+    int16_t value;
+    int8_t best_action;
+};
+
+class CombatSolver {
+   public:
+    explicit CombatSolver(const CounterAirConfig &config = kDefaultConfig)
+        : config_(config) {}
+
+    // Solves every configuration that phase 5 can start from.
+    void SolveAllEntries();
+
+    // The state must be in phase 5.
+    int Value(const CounterAirState &state);
+    Action BestAction(const CounterAirState &state);
+    // Actions up to and including the one that ends phase 5.
+    std::vector<Action> BestLine(const CounterAirState &state);
+    // Applies the best line, leaving the state at the start of phase 6.
+    void Resolve(CounterAirState *state);
+
+    int size() const { return table_.size(); }
+
+   private:
+    CombatEntry Solve(const CounterAirState &state);
+
+    CounterAirConfig config_;
+    absl::flat_hash_map<uint64_t, CombatEntry> table_;
+};
+
+}  // namespace counter_air
+}  // namespace open_spiel
+
+#endif  // OPEN_SPIEL_GAMES_COUNTER_AIR_COMBAT_H_
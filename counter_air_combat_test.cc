@@ -0,0 +1,94 @@
+// Copyright 2019 DeepMind Technologies Limited
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "open_spiel/games/counter_air_combat.h"
+
+#include <algorithm>
+#include <random>
+
+#include "open_spiel/spiel.h"
+#include "open_spiel/spiel_utils.h"
+
+namespace open_spiel {
+namespace counter_air {
+namespace {
+
+// Hits dealt by Blue minus hits dealt by Red so far.
+int NetDamage(const CounterAirState& state) {
+  const int threshold = state.config().hit_threshold;
+  return threshold * state.blue_points_ + state.red_hits_ -
+         threshold * state.red_points_ - state.blue_hits_;
+}
+
+// Plays random games and checks that the cached best line of every phase 5
+// entry is legal in the real game and realises the cached value.
+void CheckBestLines(std::shared_ptr<const Game> game) {
+  CombatSolver solver(static_cast<const CounterAirGame&>(*game).config());
+  solver.SolveAllEntries();
+  const int num_entries = solver.size();
+  std::mt19937 rng(0);
+  for (int i = 0; i < 200; ++i) {
+    std::unique_ptr<State> state = game->NewInitialState();
+    auto* cas = static_cast<CounterAirState*>(state.get());
+    while (!state->IsTerminal()) {
+      if (cas->current_phase_ == 5) {
+        CounterAirState resolved(*cas);
+        const int before = NetDamage(resolved);
+        const int value = solver.Value(resolved);
+        for (Action action : solver.BestLine(resolved)) {
+          std::vector<Action> legal = resolved.LegalActions();
+          SPIEL_CHECK_TRUE(std::find(legal.begin(), legal.end(), action) !=
+                           legal.end());
+          resolved.ApplyAction(action);
+        }
+        SPIEL_CHECK_NE(resolved.current_phase_, 5);
+        SPIEL_CHECK_EQ(NetDamage(resolved) - before, value);
+      }
+      std::vector<Action> legal = state->LegalActions();
+      std::uniform_int_distribution<int> dist(0, legal.size() - 1);
+      state->ApplyAction(legal[dist(rng)]);
+    }
+  }
+  // Random play only reaches positions below the precomputed entries.
+  SPIEL_CHECK_EQ(solver.size(), num_entries);
+}
+
+void BestLineMatchesGameTest() { CheckBestLines(LoadGame("counter_air")); }
+
+void HitThresholdTest() {
+  // A point is worth hit_threshold hits, whatever the threshold.
+  CheckBestLines(
+      LoadGame("counter_air", {{"hit_threshold", GameParameter(2)}}));
+}
+
+void ResolveTest() {
+  std::shared_ptr<const Game> game = LoadGame("counter_air");
+  std::unique_ptr<State> state = game->NewInitialState();
+  for (Action action : {2, 3, 2, 2, 2}) state->ApplyAction(action);
+  auto* cas = static_cast<CounterAirState*>(state.get());
+  SPIEL_CHECK_EQ(cas->current_phase_, 5);
+  CombatSolver solver;
+  solver.Resolve(cas);
+  SPIEL_CHECK_EQ(cas->current_phase_, 6);
+}
+
+}  // namespace
+}  // namespace counter_air
+}  // namespace open_spiel
+
+int main(int argc, char** argv) {
+  open_spiel::counter_air::BestLineMatchesGameTest();
+  open_spiel::counter_air::HitThresholdTest();
+  open_spiel::counter_air::ResolveTest();
+}
@@ -0,0 +1,349 @@
+// Copyright 2019 DeepMind Technologies Limited
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "open_spiel/games/counter_air_env_server.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <cstring>
+#include <new>
+
+#include "absl/strings/str_cat.h"
+#include "open_spiel/games/counter_air_rules.h"
+#include "open_spiel/spiel_utils.h"
+
+namespace open_spiel {
+namespace counter_air {
+namespace {
+
+constexpr char kEnvShmMagic[8] = {'C', 'A', 'E', 'N', 'V', 'S', 'H', 'M'};
+// Empty polls before a poller starts yielding its core, and before it starts
+// sleeping between polls.
+constexpr int kSpinPolls = 1024;
+constexpr int kYieldPolls = 16 * 1024;
+constexpr auto kIdleSleep = std::chrono::microseconds(50);
+
+static_assert(std::atomic<uint32_t>::is_always_lock_free,
+              "The rings need address-free atomics");
+
+size_t AlignUp(size_t size) { return (size + 63) & ~size_t{63}; }
+
+int RingCapacity(int num_envs, int num_workers) {
+    const int envs_per_worker = (num_envs + num_workers - 1) / num_workers;
+    int capacity = 1;
+    while (capacity < envs_per_worker) capacity *= 2;
+    return capacity;
+}
+
+// Offsets into the segment.
+struct EnvShmLayout {
+    size_t worker_offset;
+    size_t worker_size;  // Both rings of one worker.
+    size_t ring_size;    // Header and entries of one ring.
+    size_t slot_offset;
+    size_t size;
+};
+
+EnvShmLayout Layout(int num_envs, int num_workers, int ring_capacity) {
+    EnvShmLayout layout;
+    layout.worker_offset = AlignUp(sizeof(EnvShmHeader));
+    layout.ring_size = sizeof(EnvRingHeader) + AlignUp(ring_capacity * sizeof(uint32_t));
+    layout.worker_size = 2 * layout.ring_size;
+    layout.slot_offset = layout.worker_offset + num_workers * layout.worker_size;
+    layout.size = layout.slot_offset + num_envs * sizeof(EnvSlot);
+    return layout;
+}
+
+// Single-producer single-consumer ring over a segment region. Indices run
+// freely and are masked on access.
+class EnvRing {
+   public:
+    EnvRing(uint8_t *base, uint32_t capacity)
+        : header_(reinterpret_cast<EnvRingHeader *>(base)),
+          entries_(reinterpret_cast<uint32_t *>(base + sizeof(EnvRingHeader))),
+          mask_(capacity - 1) {}
+
+    bool TryPush(uint32_t value) {
+        const uint32_t tail = header_->tail.load(std::memory_order_relaxed);
+        if (tail - header_->head.load(std::memory_order_acquire) > mask_) return false;
+        entries_[tail & mask_] = value;
+        header_->tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool TryPop(uint32_t *value) {
+        const uint32_t head = header_->head.load(std::memory_order_relaxed);
+        if (head == header_->tail.load(std::memory_order_acquire)) return false;
+        *value = entries_[head & mask_];
+        header_->head.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+   private:
+    EnvRingHeader *header_;
+    uint32_t *entries_;
+    uint32_t mask_;
+};
+
+EnvShmHeader *Header(uint8_t *base) { return reinterpret_cast<EnvShmHeader *>(base); }
+
+EnvRing RequestRing(uint8_t *base, int worker) {
+    const EnvShmHeader *header = Header(base);
+    const EnvShmLayout layout =
+        Layout(header->num_envs, header->num_workers, header->ring_capacity);
+    return EnvRing(base + layout.worker_offset + worker * layout.worker_size,
+                   header->ring_capacity);
+}
+
+EnvRing CompletionRing(uint8_t *base, int worker) {
+    const EnvShmHeader *header = Header(base);
+    const EnvShmLayout layout =
+        Layout(header->num_envs, header->num_workers, header->ring_capacity);
+    return EnvRing(
+        base + layout.worker_offset + worker * layout.worker_size + layout.ring_size,
+        header->ring_capacity);
+}
+
+EnvSlot *Slots(uint8_t *base) {
+    const EnvShmHeader *header = Header(base);
+    const EnvShmLayout layout =
+        Layout(header->num_envs, header->num_workers, header->ring_capacity);
+    return reinterpret_cast<EnvSlot *>(base + layout.slot_offset);
+}
+
+void Backoff(int *idle) {
+    ++*idle;
+    if (*idle > kYieldPolls) {
+        std::this_thread::sleep_for(kIdleSleep);
+    } else if (*idle > kSpinPolls) {
+        std::this_thread::yield();
+    }
+}
+
+}  // namespace
+
+CounterAirEnvServer::CounterAirEnvServer(std::shared_ptr<const Game> game,
+                                         const std::string &name,
+                                         const EnvServerOptions &options)
+    : game_(game),
+      rules_(static_cast<const CounterAirGame &>(*game).rules()),
+      name_(name),
+      options_(options),
+      states_(options.num_envs),
+      steps_(new std::atomic<int64_t>[options.num_workers]) {
+    SPIEL_CHECK_GE(options_.num_envs, 1);
+    SPIEL_CHECK_LT(options_.num_envs, 1 << 28);
+    SPIEL_CHECK_GE(options_.num_workers, 1);
+    SPIEL_CHECK_LE(options_.num_workers, options_.num_envs);
+    for (int w = 0; w < options_.num_workers; w++) steps_[w] = 0;
+
+    const int ring_capacity = RingCapacity(options_.num_envs, options_.num_workers);
+    const EnvShmLayout layout = Layout(options_.num_envs, options_.num_workers, ring_capacity);
+    const int fd = shm_open(name_.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+    if (fd < 0) {
+        SpielFatalError(absl::StrCat("Could not create shared memory ", name_, ": ",
+                                     std::strerror(errno)));
+    }
+    if (ftruncate(fd, layout.size) != 0) {
+        close(fd);
+        shm_unlink(name_.c_str());
+        SpielFatalError(absl::StrCat("Could not size shared memory ", name_));
+    }
+    void *base = mmap(nullptr, layout.size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (base == MAP_FAILED) {
+        shm_unlink(name_.c_str());
+        SpielFatalError(absl::StrCat("Could not map shared memory ", name_));
+    }
+    base_ = static_cast<uint8_t *>(base);
+    size_ = layout.size;
+
+    // The new object is zero-filled, so the ring indices start at 0.
+    EnvShmHeader *header = new (base_) EnvShmHeader;
+    header->version = kEnvShmVersion;
+    header->num_envs = options_.num_envs;
+    header->num_workers = options_.num_workers;
+    header->ring_capacity = ring_capacity;
+    header->observation_size = kObservationSize;
+    header->shutdown.store(0, std::memory_order_relaxed);
+    // The magic goes last: a client that sees it sees a complete header.
+    std::atomic_thread_fence(std::memory_order_release);
+    std::memcpy(header->magic, kEnvShmMagic, sizeof(kEnvShmMagic));
+}
+
+CounterAirEnvServer::~CounterAirEnvServer() {
+    Stop();
+    munmap(base_, size_);
+    shm_unlink(name_.c_str());
+}
+
+void CounterAirEnvServer::Start() {
+    SPIEL_CHECK_TRUE(workers_.empty());
+    stop_ = false;
+    Header(base_)->shutdown.store(0, std::memory_order_release);
+    for (int w = 0; w < options_.num_workers; w++) {
+        workers_.emplace_back([this, w]() { Work(w); });
+    }
+}
+
+void CounterAirEnvServer::Stop() {
+    stop_ = true;
+    for (std::thread &worker : workers_) worker.join();
+    workers_.clear();
+    Header(base_)->shutdown.store(1, std::memory_order_release);
+}
+
+int64_t CounterAirEnvServer::steps() const {
+    int64_t total = 0;
+    for (int w = 0; w < options_.num_workers; w++) total += steps_[w];
+    return total;
+}
+
+void CounterAirEnvServer::Work(int worker) {
+    EnvRing requests = RequestRing(base_, worker);
+    EnvRing completions = CompletionRing(base_, worker);
+    EnvSlot *slots = Slots(base_);
+    const CompactState initial =
+        static_cast<const CounterAirState &>(*game_->NewInitialState()).ToCompact();
+    int idle = 0;
+    while (!stop_.load(std::memory_order_relaxed)) {
+        uint32_t request;
+        if (!requests.TryPop(&request)) {
+            Backoff(&idle);
+            continue;
+        }
+        idle = 0;
+        // The rings may be written by a binding in another language, so
+        // requests are checked even in optimised builds.
+        const uint32_t env = request >> 4;
+        const uint32_t action = request & 15;
+        SPIEL_CHECK_LT(env, static_cast<uint32_t>(options_.num_envs));
+        SPIEL_CHECK_EQ(env % options_.num_workers, static_cast<uint32_t>(worker));
+        CompactState &state = states_[env];
+        EnvSlot &slot = slots[env];
+        slot.rewards[0] = slot.rewards[1] = 0;
+        slot.done = 0;
+        if (action == kEnvResetRequest) {
+            state = initial;
+        } else {
+            SPIEL_CHECK_TRUE(RuleLegalMask(rules_, state) & (1 << action));
+            RuleApplyAction(rules_, &state, action);
+            if (RuleIsTerminal(rules_, state)) {
+                if (state.outcome == 0 || state.outcome == 1) {
+                    slot.rewards[state.outcome] = 1;
+                    slot.rewards[1 - state.outcome] = -1;
+                }
+                slot.done = 1;
+                slot.episode++;
+                state = initial;
+            }
+        }
+        CompactObservationTensor(state, absl::MakeSpan(slot.observation));
+        slot.legal_mask = RuleLegalMask(rules_, state);
+        slot.current_player = state.current_player;
+        steps_[worker].fetch_add(1, std::memory_order_relaxed);
+        // At most one request per env is outstanding, so this cannot fail.
+        SPIEL_CHECK_TRUE(completions.TryPush(env));
+    }
+}
+
+CounterAirEnvClient::CounterAirEnvClient(const std::string &name) {
+    const int fd = shm_open(name.c_str(), O_RDWR, 0);
+    if (fd < 0) {
+        SpielFatalError(absl::StrCat("Could not open shared memory ", name, ": ",
+                                     std::strerror(errno)));
+    }
+    struct stat info;
+    if (fstat(fd, &info) != 0 || info.st_size < static_cast<off_t>(sizeof(EnvShmHeader))) {
+        close(fd);
+        SpielFatalError(absl::StrCat("Shared memory ", name, " is too small"));
+    }
+    void *base = mmap(nullptr, info.st_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (base == MAP_FAILED) {
+        SpielFatalError(absl::StrCat("Could not map shared memory ", name));
+    }
+    base_ = static_cast<uint8_t *>(base);
+    size_ = info.st_size;
+
+    const EnvShmHeader *header = Header(base_);
+    if (std::memcmp(header->magic, kEnvShmMagic, sizeof(kEnvShmMagic)) != 0 ||
+        header->version != kEnvShmVersion ||
+        header->observation_size != kObservationSize ||
+        Layout(header->num_envs, header->num_workers, header->ring_capacity).size != size_) {
+        munmap(base_, size_);
+        SpielFatalError(absl::StrCat(name, " is not a counter_air env server"));
+    }
+    num_envs_ = header->num_envs;
+    num_workers_ = header->num_workers;
+}
+
+CounterAirEnvClient::~CounterAirEnvClient() { munmap(base_, size_); }
+
+void CounterAirEnvClient::Send(int env, uint32_t request) {
+    SPIEL_CHECK_GE(env, 0);
+    SPIEL_CHECK_LT(env, num_envs_);
+    SPIEL_CHECK_TRUE(RequestRing(base_, env % num_workers_)
+                         .TryPush(static_cast<uint32_t>(env) << 4 | request));
+}
+
+void CounterAirEnvClient::Reset(int env) { Send(env, kEnvResetRequest); }
+
+void CounterAirEnvClient::Step(int env, Action action) {
+    SPIEL_CHECK_TRUE(slot(env).legal_mask & (1 << action));
+    Send(env, action);
+}
+
+int CounterAirEnvClient::Poll(absl::Span<int> ready) {
+    int count = 0;
+    // Start at a different worker each time, so none is starved when `ready`
+    // is small.
+    for (int i = 0; i < num_workers_ && count < static_cast<int>(ready.size()); i++) {
+        EnvRing completions = CompletionRing(base_, (next_worker_ + i) % num_workers_);
+        uint32_t env;
+        while (count < static_cast<int>(ready.size()) && completions.TryPop(&env)) {
+            SPIEL_CHECK_LT(env, static_cast<uint32_t>(num_envs_));
+            ready[count++] = env;
+        }
+    }
+    next_worker_ = (next_worker_ + 1) % num_workers_;
+    return count;
+}
+
+int CounterAirEnvClient::Wait(absl::Span<int> ready) {
+    int idle = 0;
+    while (true) {
+        const int count = Poll(ready);
+        if (count > 0) return count;
+        if (server_shutdown()) SpielFatalError("counter_air env server shut down");
+        Backoff(&idle);
+    }
+}
+
+const EnvSlot &CounterAirEnvClient::slot(int env) const {
+    SPIEL_CHECK_GE(env, 0);
+    SPIEL_CHECK_LT(env, num_envs_);
+    return Slots(base_)[env];
+}
+
+bool CounterAirEnvClient::server_shutdown() const {
+    return Header(base_)->shutdown.load(std::memory_order_acquire) != 0;
+}
+
+}  // namespace counter_air
+}  // namespace open_spiel
@@ -0,0 +1,148 @@
+// Copyright 2019 DeepMind Technologies Limited
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef OPEN_SPIEL_GAMES_COUNTER_AIR_ENV_SERVER_H_
+#define OPEN_SPIEL_GAMES_COUNTER_AIR_ENV_SERVER_H_
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "absl/types/span.h"
+#include "open_spiel/games/counter_air.h"
+#include "open_spiel/spiel.h"
+
+// Vector environment for counter_air served over POSIX shared memory. The
+// server steps many games on its own threads; a trainer process maps the same
+// segment and exchanges requests and results with it through single-producer
+// single-consumer rings, without copies or system calls on the step path.
+//
+// Segment layout, all offsets 64-byte aligned:
+//   EnvShmHeader
+//   per worker: request ring, completion ring (EnvRingHeader + entries each)
+//   EnvSlot[num_envs]
+// Worker w owns the games w, w + num_workers, ... A request entry is
+// (env << 4) | action, with action kEnvResetRequest for a reset; a completion
+// entry is the env index. The slot of an env belongs to the server from the
+// request until the completion is published, and to the client after that.
+// A game that ends is reset straight away: its slot then holds the final
+// rewards with done set, and the observation of the next game.
+
+namespace open_spiel {
+namespace counter_air {
+
+inline constexpr uint32_t kEnvResetRequest = 15;
+inline constexpr uint32_t kEnvShmVersion = 1;
+
+struct alignas(64) EnvSlot {
+    float observation[kObservationSize];
+    float rewards[kNumPlayers];  // Non-zero only when done.
+    uint16_t legal_mask;         // Bit a is set if action a is legal.
+    int8_t current_player;
+    uint8_t done;
+    uint32_t episode;  // Games finished in this slot.
+};
+
+struct alignas(64) EnvShmHeader {
+    char magic[8];
+    uint32_t version;
+    int32_t num_envs;
+    int32_t num_workers;
+    int32_t ring_capacity;
+    int32_t observation_size;
+    std::atomic<uint32_t> shutdown;
+};
+
+struct alignas(64) EnvRingHeader {
+    // Consumer and producer indices, on separate cache lines.
+    alignas(64) std::atomic<uint32_t> head;
+    alignas(64) std::atomic<uint32_t> tail;
+};
+
+struct EnvServerOptions {
+    int num_envs = 64;
+    int num_workers = 1;
+};
+
+class CounterAirEnvServer {
+   public:
+    // Creates the shared-memory object `name` (e.g. "/counter_air_env"); it
+    // must not exist yet.
+    CounterAirEnvServer(std::shared_ptr<const Game> game, const std::string &name,
+                        const EnvServerOptions &options);
+    // Stops the workers and unlinks the segment.
+    ~CounterAirEnvServer();
+    CounterAirEnvServer(const CounterAirEnvServer &) = delete;
+    CounterAirEnvServer &operator=(const CounterAirEnvServer &) = delete;
+
+    void Start();
+    // Clients waiting on a completion fail until the server is started again.
+    void Stop();
+    // Steps and resets served so far.
+    int64_t steps() const;
+
+   private:
+    void Work(int worker);
+
+    std::shared_ptr<const Game> game_;
+    const RuleTable &rules_;
+    std::string name_;
+    EnvServerOptions options_;
+    uint8_t *base_ = nullptr;
+    size_t size_ = 0;
+    std::vector<CompactState> states_;
+    std::unique_ptr<std::atomic<int64_t>[]> steps_;
+    std::atomic<bool> stop_{false};
+    std::vector<std::thread> workers_;
+};
+
+// Trainer side. Not thread-safe: one client drives all the games of a server.
+class CounterAirEnvClient {
+   public:
+    explicit CounterAirEnvClient(const std::string &name);
+    ~CounterAirEnvClient();
+    CounterAirEnvClient(const CounterAirEnvClient &) = delete;
+    CounterAirEnvClient &operator=(const CounterAirEnvClient &) = delete;
+
+    int num_envs() const { return num_envs_; }
+    // Each env must be reset once before it is stepped, and have at most one
+    // request outstanding.
+    void Reset(int env);
+    void Step(int env, Action action);
+    // Writes the envs whose requests completed to `ready` and returns their
+    // number; does not block.
+    int Poll(absl::Span<int> ready);
+    // As Poll, but spins until at least one request completed.
+    int Wait(absl::Span<int> ready);
+    // Valid from the completion of a request until the next request.
+    const EnvSlot &slot(int env) const;
+    bool server_shutdown() const;
+
+   private:
+    void Send(int env, uint32_t request);
+
+    uint8_t *base_ = nullptr;
+    size_t size_ = 0;
+    int num_envs_ = 0;
+    int num_workers_ = 0;
+    int next_worker_ = 0;
+};
+
+}  // namespace counter_air
+}  // namespace open_spiel
+
+#endif  // OPEN_SPIEL_GAMES_COUNTER_AIR_ENV_SERVER_H_
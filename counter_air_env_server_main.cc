@@ -0,0 +1,74 @@
+// Copyright 2019 DeepMind Technologies Limited
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Serves counter_air games to trainer processes over shared memory until
+// interrupted, printing the step rate.
+
+#include <csignal>
+#include <iostream>
+#include <memory>
+#include <string>
+
+#include "absl/flags/flag.h"
+#include "absl/flags/parse.h"
+#include "absl/strings/str_format.h"
+#include "absl/time/clock.h"
+#include "absl/time/time.h"
+#include "open_spiel/games/counter_air_env_server.h"
+#include "open_spiel/spiel.h"
+
+ABSL_FLAG(std::string, game, "counter_air", "Game string, with its parameters.");
+ABSL_FLAG(std::string, name, "/counter_air_env", "Shared-memory object name.");
+ABSL_FLAG(int, num_envs, 256, "Games served.");
+ABSL_FLAG(int, num_workers, 4, "Server threads.");
+ABSL_FLAG(int, report_seconds, 10, "Seconds between step-rate lines.");
+
+namespace {
+volatile std::sig_atomic_t stop = 0;
+void HandleSignal(int) { stop = 1; }
+}  // namespace
+
+int main(int argc, char** argv) {
+    absl::ParseCommandLine(argc, argv);
+    namespace ca = open_spiel::counter_air;
+    std::shared_ptr<const open_spiel::Game> game =
+        open_spiel::LoadGame(absl::GetFlag(FLAGS_game));
+    ca::EnvServerOptions options;
+    options.num_envs = absl::GetFlag(FLAGS_num_envs);
+    options.num_workers = absl::GetFlag(FLAGS_num_workers);
+    ca::CounterAirEnvServer server(game, absl::GetFlag(FLAGS_name), options);
+    std::signal(SIGINT, HandleSignal);
+    std::signal(SIGTERM, HandleSignal);
+    server.Start();
+    std::cout << absl::StrFormat("Serving %d games on %s\n", options.num_envs,
+                                 absl::GetFlag(FLAGS_name))
+              << std::flush;
+
+    const absl::Duration report = absl::Seconds(absl::GetFlag(FLAGS_report_seconds));
+    absl::Time last_report = absl::Now();
+    int64_t last_steps = 0;
+    while (!stop) {
+        absl::SleepFor(absl::Milliseconds(100));
+        const absl::Time now = absl::Now();
+        if (now - last_report < report) continue;
+        const int64_t steps = server.steps();
+        std::cout << absl::StrFormat(
+                         "%d steps, %.0f steps/s\n", steps,
+                         (steps - last_steps) / absl::ToDoubleSeconds(now - last_report))
+                  << std::flush;
+        last_report = now;
+        last_steps = steps;
+    }
+    // The server destructor marks the segment shut down and unlinks it.
+}
@@ -0,0 +1,106 @@
+// Copyright 2019 DeepMind Technologies Limited
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "open_spiel/games/counter_air_env_server.h"
+
+#include <unistd.h>
+
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "absl/strings/str_cat.h"
+#include "open_spiel/games/counter_air.h"
+#include "open_spiel/spiel.h"
+#include "open_spiel/spiel_utils.h"
+
+namespace open_spiel {
+namespace counter_air {
+namespace {
+
+void CheckSlot(const EnvSlot& slot, const State& state) {
+  std::vector<float> observation(kObservationSize);
+  state.ObservationTensor(0, absl::MakeSpan(observation));
+  for (int i = 0; i < kObservationSize; i++) {
+    SPIEL_CHECK_EQ(slot.observation[i], observation[i]);
+  }
+  uint16_t legal_mask = 0;
+  for (Action action : state.LegalActions()) legal_mask |= 1 << action;
+  SPIEL_CHECK_EQ(slot.legal_mask, legal_mask);
+  SPIEL_CHECK_EQ(slot.current_player, state.CurrentPlayer());
+}
+
+// Plays random games through the server and through local states side by
+// side.
+void MatchesStateTest() {
+  constexpr int kNumEnvs = 12;
+  constexpr int kNumSteps = 20000;
+  std::shared_ptr<const Game> game = LoadGame("counter_air");
+  const std::string name = absl::StrCat("/counter_air_env_server_test_", getpid());
+  EnvServerOptions options;
+  options.num_envs = kNumEnvs;
+  options.num_workers = 3;
+  CounterAirEnvServer server(game, name, options);
+  server.Start();
+  CounterAirEnvClient client(name);
+  SPIEL_CHECK_EQ(client.num_envs(), kNumEnvs);
+
+  std::vector<std::unique_ptr<State>> states;
+  for (int env = 0; env < kNumEnvs; env++) {
+    states.push_back(game->NewInitialState());
+    client.Reset(env);
+  }
+  std::mt19937 rng(0);
+  std::vector<int> ready(kNumEnvs);
+  int steps = 0, episodes = 0;
+  while (steps < kNumSteps) {
+    const int count = client.Wait(absl::MakeSpan(ready));
+    for (int i = 0; i < count; i++) {
+      const int env = ready[i];
+      const EnvSlot& slot = client.slot(env);
+      if (states[env]->IsTerminal()) {
+        SPIEL_CHECK_TRUE(slot.done);
+        const std::vector<double> returns = states[env]->Returns();
+        SPIEL_CHECK_EQ(slot.rewards[0], returns[0]);
+        SPIEL_CHECK_EQ(slot.rewards[1], returns[1]);
+        states[env] = game->NewInitialState();
+        episodes++;
+      } else {
+        SPIEL_CHECK_FALSE(slot.done);
+        SPIEL_CHECK_EQ(slot.rewards[0], 0);
+      }
+      CheckSlot(slot, *states[env]);
+      std::vector<Action> actions = states[env]->LegalActions();
+      const Action action = actions[rng() % actions.size()];
+      states[env]->ApplyAction(action);
+      client.Step(env, action);
+      steps++;
+    }
+  }
+  SPIEL_CHECK_GT(episodes, 0);
+  SPIEL_CHECK_FALSE(client.server_shutdown());
+  server.Stop();
+  SPIEL_CHECK_TRUE(client.server_shutdown());
+  SPIEL_CHECK_GE(server.steps(), kNumSteps);
+  server.Start();
+  SPIEL_CHECK_FALSE(client.server_shutdown());
+  server.Stop();
+}
+
+}  // namespace
+}  // namespace counter_air
+}  // namespace open_spiel
+
+int main(int argc, char** argv) { open_spiel::counter_air::MatchesStateTest(); }
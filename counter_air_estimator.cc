@@ -0,0 +1,167 @@
+// Copyright 2019 DeepMind Technologies Limited
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "open_spiel/games/counter_air_estimator.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <thread>
+#include <vector>
+
+#include "absl/time/clock.h"
+#include "open_spiel/games/counter_air_rules.h"
+#include "open_spiel/spiel_utils.h"
+
+namespace open_spiel {
+namespace counter_air {
+namespace {
+
+// Playouts a worker runs between looks at the shared counters.
+constexpr int64_t kBatchSize = 32;
+
+Action UniformAction(uint16_t legal_mask, std::mt19937_64 *rng) {
+    int num_legal = 0;
+    for (uint16_t mask = legal_mask; mask; mask &= mask - 1) num_legal++;
+    int pick = std::uniform_int_distribution<int>(0, num_legal - 1)(*rng);
+    for (int action = 0;; action++) {
+        if ((legal_mask & (1 << action)) && pick-- == 0) return action;
+    }
+}
+
+// Plays `state` out and returns its outcome field.
+int Playout(const RuleTable &rules, const RolloutPolicy &policy,
+            CompactState state, std::mt19937_64 *rng) {
+    while (true) {
+        const uint16_t legal = RuleLegalMask(rules, state);
+        if (legal == 0) return state.outcome;
+        const Action action = policy ? policy(state, legal, rng)
+                                     : UniformAction(legal, rng);
+        SPIEL_DCHECK_TRUE(legal & (1 << action));
+        RuleApplyAction(rules, &state, action);
+    }
+}
+
+struct SharedCounts {
+    std::atomic<int64_t> claimed{0};
+    std::atomic<int64_t> blue_wins{0};
+    std::atomic<int64_t> draws{0};
+    std::atomic<int64_t> red_wins{0};
+    std::atomic<bool> stop{false};
+};
+
+void Fill(int64_t blue_wins, int64_t draws, int64_t red_wins, double z,
+          WinRateEstimate *estimate) {
+    estimate->blue_wins = blue_wins;
+    estimate->draws = draws;
+    estimate->red_wins = red_wins;
+    estimate->num_samples = blue_wins + draws + red_wins;
+    estimate->blue_win_interval = WilsonInterval(blue_wins, estimate->num_samples, z);
+    estimate->draw_interval = WilsonInterval(draws, estimate->num_samples, z);
+    estimate->red_win_interval = WilsonInterval(red_wins, estimate->num_samples, z);
+}
+
+bool NarrowEnough(const WinRateEstimate &estimate, double half_width) {
+    for (const Interval &interval :
+         {estimate.blue_win_interval, estimate.draw_interval,
+          estimate.red_win_interval}) {
+        if (interval.high - interval.low > 2 * half_width) return false;
+    }
+    return true;
+}
+
+}  // namespace
+
+double WinRateEstimate::BlueWinRate() const {
+    return num_samples == 0 ? 0.0 : static_cast<double>(blue_wins) / num_samples;
+}
+
+double WinRateEstimate::DrawRate() const {
+    return num_samples == 0 ? 0.0 : static_cast<double>(draws) / num_samples;
+}
+
+double WinRateEstimate::RedWinRate() const {
+    return num_samples == 0 ? 0.0 : static_cast<double>(red_wins) / num_samples;
+}
+
+Interval WilsonInterval(int64_t successes, int64_t samples, double z) {
+    if (samples == 0) return {0.0, 1.0};
+    const double n = samples;
+    const double p = successes / n;
+    const double z2 = z * z;
+    const double center = (p + z2 / (2 * n)) / (1 + z2 / n);
+    const double margin =
+        z * std::sqrt(p * (1 - p) / n + z2 / (4 * n * n)) / (1 + z2 / n);
+    return {std::max(0.0, center - margin), std::min(1.0, center + margin)};
+}
+
+WinRateEstimate EstimateWinRate(const CounterAirState &state,
+                                const EstimatorOptions &options) {
+    SPIEL_CHECK_GT(options.max_samples, 0);
+    const RuleTable &rules =
+        static_cast<const CounterAirGame &>(*state.GetGame()).rules();
+    const CompactState root = state.ToCompact();
+    const absl::Time start = absl::Now();
+    const absl::Time deadline = start + options.max_time;
+    int num_threads = options.num_threads;
+    if (num_threads <= 0) {
+        num_threads = std::max<int>(1, std::thread::hardware_concurrency());
+    }
+
+    SharedCounts shared;
+    auto worker = [&](int thread_index) {
+        // seed_seq keeps 32 bits of each value, so split the seed.
+        std::seed_seq seq{static_cast<uint32_t>(options.seed),
+                          static_cast<uint32_t>(options.seed >> 32),
+                          static_cast<uint32_t>(thread_index)};
+        std::mt19937_64 rng(seq);
+        while (!shared.stop.load(std::memory_order_relaxed)) {
+            const int64_t first = shared.claimed.fetch_add(kBatchSize);
+            if (first >= options.max_samples) break;
+            const int64_t count = std::min(kBatchSize, options.max_samples - first);
+            int64_t outcomes[3] = {0, 0, 0};  // Blue win, draw, Red win.
+            for (int64_t i = 0; i < count; i++) {
+                const int outcome = Playout(rules, options.policy, root, &rng);
+                outcomes[outcome == 0 ? 0 : (outcome == 1 ? 2 : 1)]++;
+            }
+            const int64_t blue_wins = shared.blue_wins.fetch_add(outcomes[0]) + outcomes[0];
+            const int64_t draws = shared.draws.fetch_add(outcomes[1]) + outcomes[1];
+            const int64_t red_wins = shared.red_wins.fetch_add(outcomes[2]) + outcomes[2];
+
+            if (absl::Now() >= deadline) {
+                shared.stop = true;
+            } else if (options.target_half_width > 0 &&
+                       blue_wins + draws + red_wins >= options.min_samples) {
+                WinRateEstimate partial;
+                Fill(blue_wins, draws, red_wins, options.z, &partial);
+                if (NarrowEnough(partial, options.target_half_width)) {
+                    shared.stop = true;
+                }
+            }
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for (int t = 1; t < num_threads; t++) threads.emplace_back(worker, t);
+    worker(0);
+    for (std::thread &thread : threads) thread.join();
+
+    WinRateEstimate estimate;
+    Fill(shared.blue_wins, shared.draws, shared.red_wins, options.z, &estimate);
+    estimate.elapsed = absl::Now() - start;
+    return estimate;
+}
+
+}  // namespace counter_air
+}  // namespace open_spiel
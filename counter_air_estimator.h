@@ -0,0 +1,86 @@
+// Copyright 2019 DeepMind Technologies Limited
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef OPEN_SPIEL_GAMES_COUNTER_AIR_ESTIMATOR_H_
+#define OPEN_SPIEL_GAMES_COUNTER_AIR_ESTIMATOR_H_
+
+#include <cstdint>
+#include <functional>
+#include <random>
+
+#include "absl/time/time.h"
+#include "open_spiel/games/counter_air.h"
+#include "open_spiel/spiel.h"
+
+// Monte Carlo estimate of who is winning a position. Playouts run on the
+// table-driven rule engine over CompactStates kept on the stack of each worker
+// thread, and every thread draws from its own random stream derived from the
+// seed. Sampling stops at the sample limit, at the time limit, or once every
+// confidence interval is narrower than the requested half-width, whichever
+// comes first.
+
+namespace open_spiel {
+namespace counter_air {
+
+// Picks one of the actions set in `legal_mask` (bit i for action i).
+using RolloutPolicy = std::function<Action(
+    const CompactState &state, uint16_t legal_mask, std::mt19937_64 *rng)>;
+
+struct EstimatorOptions {
+    // Uniformly random playouts if empty.
+    RolloutPolicy policy;
+    int64_t max_samples = 10000;
+    absl::Duration max_time = absl::InfiniteDuration();
+    // Stops early once all three intervals have at most this half-width; 0
+    // never stops early.
+    double target_half_width = 0.0;
+    int64_t min_samples = 100;
+    // Critical value of the intervals; 1.96 for 95%.
+    double z = 1.96;
+    int num_threads = 0;  // 0 uses all hardware threads.
+    uint64_t seed = 0;
+};
+
+struct Interval {
+    double low;
+    double high;
+};
+
+struct WinRateEstimate {
+    int64_t num_samples = 0;
+    int64_t blue_wins = 0;
+    int64_t draws = 0;
+    int64_t red_wins = 0;
+    // Wilson score intervals of the three rates.
+    Interval blue_win_interval{0.0, 1.0};
+    Interval draw_interval{0.0, 1.0};
+    Interval red_win_interval{0.0, 1.0};
+    absl::Duration elapsed;
+
+    double BlueWinRate() const;
+    double DrawRate() const;
+    double RedWinRate() const;
+};
+
+// Thread-safe; the state is only read.
+WinRateEstimate EstimateWinRate(const CounterAirState &state,
+                                const EstimatorOptions &options = {});
+
+// The Wilson score interval of `successes` out of `samples`.
+Interval WilsonInterval(int64_t successes, int64_t samples, double z);
+
+}  // namespace counter_air
+}  // namespace open_spiel
+
+#endif  // OPEN_SPIEL_GAMES_COUNTER_AIR_ESTIMATOR_H_
@@ -0,0 +1,130 @@
+// Copyright 2019 DeepMind Technologies Limited
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "open_spiel/games/counter_air_estimator.h"
+
+#include <memory>
+#include <random>
+
+#include "absl/time/time.h"
+#include "open_spiel/games/counter_air.h"
+#include "open_spiel/spiel.h"
+#include "open_spiel/spiel_utils.h"
+
+namespace open_spiel {
+namespace counter_air {
+namespace {
+
+const CounterAirState& Root(const State& state) {
+  return static_cast<const CounterAirState&>(state);
+}
+
+void WilsonIntervalTest() {
+  Interval interval = WilsonInterval(50, 100, 1.96);
+  SPIEL_CHECK_FLOAT_NEAR(interval.low, 0.4038, 1e-3);
+  SPIEL_CHECK_FLOAT_NEAR(interval.high, 0.5962, 1e-3);
+  interval = WilsonInterval(0, 10, 1.96);
+  SPIEL_CHECK_EQ(interval.low, 0.0);
+  SPIEL_CHECK_GT(interval.high, 0.0);
+}
+
+void RandomPlayoutsTest() {
+  std::shared_ptr<const Game> game = LoadGame("counter_air");
+  std::unique_ptr<State> state = game->NewInitialState();
+  EstimatorOptions options;
+  options.max_samples = 2000;
+  options.num_threads = 4;
+  WinRateEstimate estimate = EstimateWinRate(Root(*state), options);
+  SPIEL_CHECK_EQ(estimate.num_samples, 2000);
+  SPIEL_CHECK_EQ(estimate.blue_wins + estimate.draws + estimate.red_wins, 2000);
+  SPIEL_CHECK_FLOAT_NEAR(
+      estimate.BlueWinRate() + estimate.DrawRate() + estimate.RedWinRate(), 1.0,
+      1e-9);
+  SPIEL_CHECK_LE(estimate.blue_win_interval.low, estimate.BlueWinRate());
+  SPIEL_CHECK_GE(estimate.blue_win_interval.high, estimate.BlueWinRate());
+  SPIEL_CHECK_LE(estimate.red_win_interval.low, estimate.RedWinRate());
+  SPIEL_CHECK_GE(estimate.red_win_interval.high, estimate.RedWinRate());
+
+  // A single thread with a fixed seed is reproducible.
+  options.num_threads = 1;
+  options.max_samples = 500;
+  WinRateEstimate first = EstimateWinRate(Root(*state), options);
+  WinRateEstimate second = EstimateWinRate(Root(*state), options);
+  SPIEL_CHECK_EQ(first.blue_wins, second.blue_wins);
+  SPIEL_CHECK_EQ(first.red_wins, second.red_wins);
+
+  // All 64 bits of the seed matter.
+  options.seed += uint64_t{1} << 32;
+  WinRateEstimate other = EstimateWinRate(Root(*state), options);
+  SPIEL_CHECK_TRUE(other.blue_wins != first.blue_wins ||
+                   other.red_wins != first.red_wins);
+}
+
+void PolicyTest() {
+  // Always taking the lowest legal action is deterministic; compare it with
+  // the same line played on the game itself.
+  std::shared_ptr<const Game> game = LoadGame("counter_air");
+  std::unique_ptr<State> state = game->NewInitialState();
+  EstimatorOptions options;
+  options.max_samples = 100;
+  options.num_threads = 2;
+  options.policy = [](const CompactState&, uint16_t legal_mask,
+                      std::mt19937_64*) -> Action {
+    for (Action action = 0;; action++) {
+      if (legal_mask & (1 << action)) return action;
+    }
+  };
+  WinRateEstimate estimate = EstimateWinRate(Root(*state), options);
+
+  std::unique_ptr<State> line = state->Clone();
+  while (!line->IsTerminal()) line->ApplyAction(line->LegalActions()[0]);
+  const std::vector<double> returns = line->Returns();
+  if (returns[0] > 0) {
+    SPIEL_CHECK_EQ(estimate.blue_wins, 100);
+  } else if (returns[1] > 0) {
+    SPIEL_CHECK_EQ(estimate.red_wins, 100);
+  } else {
+    SPIEL_CHECK_EQ(estimate.draws, 100);
+  }
+}
+
+void StoppingTest() {
+  std::shared_ptr<const Game> game = LoadGame("counter_air");
+  std::unique_ptr<State> state = game->NewInitialState();
+  EstimatorOptions options;
+  options.max_samples = 1000000;
+  options.target_half_width = 0.05;
+  options.num_threads = 2;
+  WinRateEstimate estimate = EstimateWinRate(Root(*state), options);
+  SPIEL_CHECK_LT(estimate.num_samples, options.max_samples);
+  SPIEL_CHECK_LE(estimate.blue_win_interval.high - estimate.blue_win_interval.low,
+                 0.1);
+
+  options.target_half_width = 0.0;
+  options.max_time = absl::Milliseconds(50);
+  estimate = EstimateWinRate(Root(*state), options);
+  SPIEL_CHECK_LT(estimate.num_samples, options.max_samples);
+  SPIEL_CHECK_GT(estimate.num_samples, 0);
+}
+
+}  // namespace
+}  // namespace counter_air
+}  // namespace open_spiel
+
+int main(int argc, char** argv) {
+  open_spiel::counter_air::WilsonIntervalTest();
+  open_spiel::counter_air::RandomPlayoutsTest();
+  open_spiel::counter_air::PolicyTest();
+  open_spiel::counter_air::StoppingTest();
+}
@@ -0,0 +1,156 @@
+// Copyright 2019 DeepMind Technologies Limited
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "open_spiel/games/counter_air_eval.h"
+
+#include <cmath>
+#include <memory>
+#include <random>
+
+#include "open_spiel/games/counter_air_estimator.h"
+#include "open_spiel/spiel_utils.h"
+
+namespace open_spiel {
+namespace counter_air {
+
+// Output of counter_air_tune_main --num_games=2000 --iterations=20000.
+const EvalWeights kDefaultEvalWeights = {
+    0.3897, 1.0078, 0.2926, 0.2812, 0.0084, 0.8352, 0.1355, -0.5395, 0.8854, -1.2161,
+};
+
+namespace {
+
+double TerminalBlueReturn(const CompactState &state) {
+    if (state.outcome == 0) return 1;
+    if (state.outcome == 1) return -1;
+    return 0;
+}
+
+bool IsTerminal(const CompactState &state, const CounterAirConfig &config) {
+    return state.outcome != kInvalidPlayer || state.current_wave == config.num_waves;
+}
+
+// Forces may be configured empty; their features are then 0.
+double Fraction(int count, int total) {
+    return total == 0 ? 0.0 : static_cast<double>(count) / total;
+}
+
+double Dot(const EvalWeights &weights, const EvalFeatures &features) {
+    double sum = 0;
+    for (int i = 0; i < kNumEvalFeatures; i++) sum += weights[i] * features[i];
+    return sum;
+}
+
+}  // namespace
+
+EvalFeatures ExtractEvalFeatures(const CompactState &state,
+                                 const CounterAirConfig &config) {
+    const auto &b = state.board;
+    EvalFeatures features;
+    features[kBiasFeature] = 1;
+    int blue_fighters = state.blue_placeable_fighters;
+    for (int i = 0; i <= 7; i++) blue_fighters += b[i];
+    features[kBlueFightersFeature] = Fraction(blue_fighters, config.blue_fighters);
+    features[kRedFightersFeature] = Fraction(
+        state.red_placeable_fighters + b[8] + b[9] + b[14] + b[15], config.red_fighters);
+    features[kRedSamsFeature] = Fraction(
+        state.red_placeable_sams + b[10] + b[11] + b[12] + b[13], config.red_sams);
+    features[kAaaFeature] = Fraction(b[16] + b[17], config.num_aaa);
+    const double progress = static_cast<double>(state.current_wave) / config.num_waves;
+    const int margin = state.blue_points - state.red_points - 2;
+    features[kPointsMarginFeature] = margin;
+    features[kLatePointsFeature] = margin * progress;
+    features[kBlueHitsFeature] = static_cast<double>(state.blue_hits) / config.hit_threshold;
+    features[kRedHitsFeature] = static_cast<double>(state.red_hits) / config.hit_threshold;
+    features[kProgressFeature] = progress;
+    return features;
+}
+
+double CounterAirEvaluator::Evaluate(const CompactState &state) const {
+    if (IsTerminal(state, config_)) return TerminalBlueReturn(state);
+    return std::tanh(Dot(weights_, ExtractEvalFeatures(state, config_)));
+}
+
+std::vector<EvalSample> RolloutEvalSamples(const Game &game, int num_games,
+                                           double sample_rate,
+                                           int rollouts_per_sample, uint64_t seed) {
+    std::mt19937_64 rng(seed);
+    std::uniform_real_distribution<double> coin(0.0, 1.0);
+    EstimatorOptions options;
+    options.max_samples = rollouts_per_sample;
+    options.num_threads = 1;
+    std::vector<EvalSample> samples;
+    for (int i = 0; i < num_games; i++) {
+        std::unique_ptr<State> state = game.NewInitialState();
+        while (!state->IsTerminal()) {
+            const auto &counter_air = static_cast<const CounterAirState &>(*state);
+            if (coin(rng) < sample_rate) {
+                options.seed = rng();
+                const WinRateEstimate estimate = EstimateWinRate(counter_air, options);
+                samples.push_back({counter_air.ToCompact(),
+                                   estimate.BlueWinRate() - estimate.RedWinRate()});
+            }
+            std::vector<Action> actions = state->LegalActions();
+            state->ApplyAction(actions[rng() % actions.size()]);
+        }
+    }
+    return samples;
+}
+
+double EvalLoss(const CounterAirEvaluator &evaluator,
+                const std::vector<EvalSample> &samples) {
+    if (samples.empty()) return 0;
+    double loss = 0;
+    for (const EvalSample &sample : samples) {
+        const double error = evaluator.Evaluate(sample.state) - sample.target;
+        loss += error * error;
+    }
+    return loss / samples.size();
+}
+
+EvalWeights FitEvalWeights(const std::vector<EvalSample> &samples,
+                           const CounterAirConfig &config,
+                           const EvalWeights &initial,
+                           const EvalFitOptions &options) {
+    // Terminal states are scored exactly and take no part in the fit.
+    std::vector<EvalFeatures> features;
+    std::vector<double> targets;
+    for (const EvalSample &sample : samples) {
+        if (IsTerminal(sample.state, config)) continue;
+        features.push_back(ExtractEvalFeatures(sample.state, config));
+        targets.push_back(sample.target);
+    }
+    SPIEL_CHECK_FALSE(features.empty());
+    EvalWeights weights = initial;
+    for (int iteration = 0; iteration < options.iterations; iteration++) {
+        EvalWeights gradient{};
+        for (size_t i = 0; i < features.size(); i++) {
+            const double prediction = std::tanh(Dot(weights, features[i]));
+            // d/dz (tanh z - t)^2 = 2 (tanh z - t) (1 - tanh^2 z)
+            const double scale =
+                2 * (prediction - targets[i]) * (1 - prediction * prediction);
+            for (int f = 0; f < kNumEvalFeatures; f++) {
+                gradient[f] += scale * features[i][f];
+            }
+        }
+        for (int f = 0; f < kNumEvalFeatures; f++) {
+            gradient[f] = gradient[f] / features.size() + 2 * options.l2 * weights[f];
+            weights[f] -= options.learning_rate * gradient[f];
+        }
+    }
+    return weights;
+}
+
+}  // namespace counter_air
+}  // namespace open_spiel
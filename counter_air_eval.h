@@ -0,0 +1,110 @@
+// Copyright 2019 DeepMind Technologies Limited
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef OPEN_SPIEL_GAMES_COUNTER_AIR_EVAL_H_
+#define OPEN_SPIEL_GAMES_COUNTER_AIR_EVAL_H_
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+#include "open_spiel/games/counter_air.h"
+#include "open_spiel/spiel.h"
+
+// Static evaluation of counter_air positions for cutting search off before
+// the end of the game. The evaluator is tanh of a linear function of a few
+// features: the material left to both sides, the points and hit counters, and
+// how much of the game remains. Terminal states get their exact return. The
+// weights are fitted to positions scored by playouts or by a solver.
+
+namespace open_spiel {
+namespace counter_air {
+
+enum EvalFeature {
+    kBiasFeature,
+    // Forces on the board and still to be placed, as fractions of the
+    // starting forces; 0 for a force configured empty.
+    kBlueFightersFeature,
+    kRedFightersFeature,
+    kRedSamsFeature,
+    kAaaFeature,
+    kPointsMarginFeature,   // Blue points over Red points plus the 2 needed.
+    kLatePointsFeature,     // The margin weighted by the fraction of waves played.
+    kBlueHitsFeature,       // As fractions of the hit threshold.
+    kRedHitsFeature,
+    kProgressFeature,       // Fraction of waves played.
+    kNumEvalFeatures,
+};
+
+using EvalWeights = std::array<double, kNumEvalFeatures>;
+using EvalFeatures = std::array<double, kNumEvalFeatures>;
+
+// Fitted with counter_air_tune_main on positions of the standard game scored by
+// random playouts.
+extern const EvalWeights kDefaultEvalWeights;
+
+EvalFeatures ExtractEvalFeatures(const CompactState &state,
+                                 const CounterAirConfig &config);
+
+class CounterAirEvaluator {
+   public:
+    explicit CounterAirEvaluator(const CounterAirConfig &config = kDefaultConfig,
+                                 const EvalWeights &weights = kDefaultEvalWeights)
+        : config_(config), weights_(weights) {}
+
+    // Blue's expected return, in [-1, 1].
+    double Evaluate(const CompactState &state) const;
+    double Evaluate(const CounterAirState &state) const {
+        return Evaluate(state.ToCompact());
+    }
+
+    const EvalWeights &weights() const { return weights_; }
+
+   private:
+    CounterAirConfig config_;
+    EvalWeights weights_;
+};
+
+// A position and the Blue return it is fitted to.
+struct EvalSample {
+    CompactState state;
+    double target;
+};
+
+// Scores the positions of `num_games` random games, sampling each one with
+// probability `sample_rate`, by the mean Blue return of random playouts.
+std::vector<EvalSample> RolloutEvalSamples(const Game &game, int num_games,
+                                           double sample_rate,
+                                           int rollouts_per_sample, uint64_t seed);
+
+struct EvalFitOptions {
+    int iterations = 2000;
+    double learning_rate = 0.05;
+    double l2 = 1e-4;
+};
+
+// Mean squared error of the evaluator on `samples`.
+double EvalLoss(const CounterAirEvaluator &evaluator,
+                const std::vector<EvalSample> &samples);
+
+// Gradient descent on the mean squared error, starting from `initial`.
+EvalWeights FitEvalWeights(const std::vector<EvalSample> &samples,
+                           const CounterAirConfig &config,
+                           const EvalWeights &initial,
+                           const EvalFitOptions &options = {});
+
+}  // namespace counter_air
+}  // namespace open_spiel
+
+#endif  // OPEN_SPIEL_GAMES_COUNTER_AIR_EVAL_H_
@@ -0,0 +1,96 @@
+// Copyright 2019 DeepMind Technologies Limited
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "open_spiel/games/counter_air_eval.h"
+
+#include <cmath>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "open_spiel/games/counter_air.h"
+#include "open_spiel/spiel.h"
+#include "open_spiel/spiel_utils.h"
+
+namespace open_spiel {
+namespace counter_air {
+namespace {
+
+void EvaluateTest() {
+  std::shared_ptr<const Game> game = LoadGame("counter_air");
+  CounterAirEvaluator evaluator;
+  std::mt19937 rng(0);
+  for (int i = 0; i < 20; i++) {
+    std::unique_ptr<State> state = game->NewInitialState();
+    while (!state->IsTerminal()) {
+      const double value =
+          evaluator.Evaluate(static_cast<const CounterAirState&>(*state));
+      SPIEL_CHECK_GE(value, -1);
+      SPIEL_CHECK_LE(value, 1);
+      std::vector<Action> actions = state->LegalActions();
+      state->ApplyAction(actions[rng() % actions.size()]);
+    }
+    // Terminal states are scored by their returns.
+    SPIEL_CHECK_EQ(evaluator.Evaluate(static_cast<const CounterAirState&>(*state)),
+                   state->Returns()[0]);
+  }
+}
+
+void FitTest() {
+  // Targets made by known weights are fitted closely.
+  std::shared_ptr<const Game> game = LoadGame("counter_air");
+  const EvalWeights truth = {0.2, 0.8, -0.6, -0.3, 0.1, 0.7, 0.4, -0.5, 0.5, 0.0};
+  const CounterAirEvaluator teacher(kDefaultConfig, truth);
+  std::vector<EvalSample> samples;
+  std::mt19937 rng(1);
+  for (int i = 0; i < 50; i++) {
+    std::unique_ptr<State> state = game->NewInitialState();
+    while (!state->IsTerminal()) {
+      const CompactState compact =
+          static_cast<const CounterAirState&>(*state).ToCompact();
+      samples.push_back({compact, teacher.Evaluate(compact)});
+      std::vector<Action> actions = state->LegalActions();
+      state->ApplyAction(actions[rng() % actions.size()]);
+    }
+  }
+  EvalFitOptions options;
+  options.iterations = 3000;
+  options.learning_rate = 0.5;
+  options.l2 = 0;
+  const EvalWeights zero{};
+  const EvalWeights fitted = FitEvalWeights(samples, kDefaultConfig, zero, options);
+  const double loss = EvalLoss(CounterAirEvaluator(kDefaultConfig, fitted), samples);
+  SPIEL_CHECK_LT(loss, 1e-3);
+  SPIEL_CHECK_LT(loss, EvalLoss(CounterAirEvaluator(kDefaultConfig, zero), samples));
+}
+
+void RolloutSamplesTest() {
+  std::shared_ptr<const Game> game = LoadGame("counter_air");
+  std::vector<EvalSample> samples = RolloutEvalSamples(*game, 5, 0.2, 20, 0);
+  SPIEL_CHECK_FALSE(samples.empty());
+  for (const EvalSample& sample : samples) {
+    SPIEL_CHECK_GE(sample.target, -1);
+    SPIEL_CHECK_LE(sample.target, 1);
+  }
+}
+
+}  // namespace
+}  // namespace counter_air
+}  // namespace open_spiel
+
+int main(int argc, char** argv) {
+  open_spiel::counter_air::EvaluateTest();
+  open_spiel::counter_air::FitTest();
+  open_spiel::counter_air::RolloutSamplesTest();
+}
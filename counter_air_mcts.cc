@@ -0,0 +1,168 @@
+// Copyright 2019 DeepMind Technologies Limited
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "open_spiel/games/counter_air_mcts.h"
+
+#include <cmath>
+#include <utility>
+#include <vector>
+
+#include "absl/numeric/bits.h"
+#include "open_spiel/games/counter_air_rules.h"
+#include "open_spiel/spiel_utils.h"
+
+namespace open_spiel {
+namespace counter_air {
+namespace {
+
+double TerminalBlueReturn(const CompactState &state) {
+    if (state.outcome == 0) return 1;
+    if (state.outcome == 1) return -1;
+    return 0;
+}
+
+// Key of the child reached by `action` in tree mode.
+uint64_t PathKey(uint64_t parent_key, Action action) {
+    uint64_t hash = parent_key + 0x9e3779b97f4a7c15ULL * (action + 1);
+    hash = (hash ^ (hash >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    hash = (hash ^ (hash >> 27)) * 0x94d049bb133111ebULL;
+    return hash ^ (hash >> 31);
+}
+
+}  // namespace
+
+CounterAirMcts::CounterAirMcts(std::shared_ptr<const Game> game,
+                               const MctsOptions &options)
+    : game_(game),
+      rules_(static_cast<const CounterAirGame &>(*game).rules()),
+      options_(options),
+      rng_(options.seed) {}
+
+uint64_t CounterAirMcts::Key(const CompactState &state, uint64_t parent_key,
+                             Action action) const {
+    return options_.dag ? CanonicalStateKey(state) : PathKey(parent_key, action);
+}
+
+CounterAirMcts::Node &CounterAirMcts::Expand(uint64_t key, const CompactState &state) {
+    Node &node = nodes_[key];
+    node.legal = RuleLegalMask(rules_, state);
+    node.player = state.current_player;
+    for (int action = 0; action < kNumDistinctActions; action++) {
+        if (!(node.legal & (1 << action))) continue;
+        CompactState child = state;
+        RuleApplyAction(rules_, &child, action);
+        node.child_keys[action] = Key(child, key, action);
+    }
+    return node;
+}
+
+Action CounterAirMcts::Select(const Node &node) {
+    // Unvisited edges first, in random order.
+    Action unvisited = kInvalidAction;
+    int num_unvisited = 0;
+    for (int action = 0; action < kNumDistinctActions; action++) {
+        if ((node.legal & (1 << action)) && node.edge_visits[action] == 0 &&
+            rng_() % ++num_unvisited == 0) {
+            unvisited = action;
+        }
+    }
+    if (unvisited != kInvalidAction) return unvisited;
+
+    const double sign = node.player == 0 ? 1 : -1;
+    const double log_visits = std::log(static_cast<double>(node.visits));
+    Action best = kInvalidAction;
+    double best_score = -1e300;
+    for (int action = 0; action < kNumDistinctActions; action++) {
+        if (!(node.legal & (1 << action))) continue;
+        // With shared nodes the child's value includes simulations that came
+        // through other parents.
+        const Node &child = nodes_.at(node.child_keys[action]);
+        const double score =
+            sign * child.value_sum / child.visits +
+            options_.uct_c * std::sqrt(log_visits / node.edge_visits[action]);
+        if (score > best_score) {
+            best_score = score;
+            best = action;
+        }
+    }
+    return best;
+}
+
+double CounterAirMcts::Rollout(CompactState state) {
+    while (!RuleIsTerminal(rules_, state)) {
+        uint16_t legal = RuleLegalMask(rules_, state);
+        for (int skip = rng_() % absl::popcount(legal); skip > 0; skip--) {
+            legal &= legal - 1;
+        }
+        RuleApplyAction(rules_, &state, absl::countr_zero(legal));
+    }
+    return TerminalBlueReturn(state);
+}
+
+MctsResult CounterAirMcts::Search(const CounterAirState &state) {
+    SPIEL_CHECK_FALSE(state.IsTerminal());
+    const CompactState root = state.ToCompact();
+    const uint64_t root_key = options_.dag ? CanonicalStateKey(root) : CompactStateKey(root);
+    if (!nodes_.contains(root_key)) Expand(root_key, root);
+
+    // (node key, action taken there), the leaf with kInvalidAction.
+    std::vector<std::pair<uint64_t, Action>> path;
+    for (int sim = 0; sim < options_.num_simulations; sim++) {
+        path.clear();
+        CompactState current = root;
+        uint64_t key = root_key;
+        double value;
+        while (true) {
+            const Node &node = nodes_.at(key);
+            if (node.legal == 0) {
+                path.push_back({key, kInvalidAction});
+                value = TerminalBlueReturn(current);
+                break;
+            }
+            const Action action = Select(node);
+            path.push_back({key, action});
+            RuleApplyAction(rules_, &current, action);
+            key = node.child_keys[action];
+            if (!nodes_.contains(key)) {
+                Expand(key, current);
+                path.push_back({key, kInvalidAction});
+                value = RuleIsTerminal(rules_, current) ? TerminalBlueReturn(current)
+                                                        : Rollout(current);
+                break;
+            }
+        }
+        for (const auto &[node_key, action] : path) {
+            Node &node = nodes_.at(node_key);
+            node.visits++;
+            node.value_sum += value;
+            if (action != kInvalidAction) node.edge_visits[action]++;
+        }
+    }
+
+    const Node &node = nodes_.at(root_key);
+    MctsResult result;
+    result.simulations = node.visits;
+    result.value = node.value_sum / node.visits;
+    for (int action = 0; action < kNumDistinctActions; action++) {
+        if (!(node.legal & (1 << action))) continue;
+        if (result.best_action == kInvalidAction ||
+            node.edge_visits[action] > node.edge_visits[result.best_action]) {
+            result.best_action = action;
+        }
+    }
+    return result;
+}
+
+}  // namespace counter_air
+}  // namespace open_spiel
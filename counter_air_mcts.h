@@ -0,0 +1,85 @@
+// Copyright 2019 DeepMind Technologies Limited
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef OPEN_SPIEL_GAMES_COUNTER_AIR_MCTS_H_
+#define OPEN_SPIEL_GAMES_COUNTER_AIR_MCTS_H_
+
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <random>
+
+#include "absl/container/flat_hash_map.h"
+#include "open_spiel/games/counter_air.h"
+#include "open_spiel/spiel.h"
+
+// UCT search for counter_air over CompactState, with random rollouts. In DAG
+// mode nodes are keyed by CanonicalStateKey(), so every path reaching the
+// same canonical state shares one node and its statistics: a node's value is
+// the mean over all simulations through it, whichever parent they came from,
+// while exploration uses the visit counts of the edges. In tree mode every
+// path has nodes of its own, as in plain MCTS.
+
+namespace open_spiel {
+namespace counter_air {
+
+struct MctsOptions {
+    int num_simulations = 10000;
+    double uct_c = 1.4;
+    bool dag = true;
+    uint64_t seed = 0;
+};
+
+struct MctsResult {
+    Action best_action = kInvalidAction;  // The most visited.
+    double value = 0;                     // Blue's mean return at the root.
+    int64_t simulations = 0;
+};
+
+class CounterAirMcts {
+   public:
+    CounterAirMcts(std::shared_ptr<const Game> game, const MctsOptions &options);
+
+    // Runs options.num_simulations more simulations from `state`, which must
+    // not be terminal. Nodes are kept between searches until Reset().
+    MctsResult Search(const CounterAirState &state);
+    void Reset() { nodes_.clear(); }
+    int64_t num_nodes() const { return nodes_.size(); }
+
+   private:
+    struct Node {
+        int64_t visits = 0;
+        double value_sum = 0;  // Blue's returns.
+        uint16_t legal = 0;
+        int8_t player = 0;
+        std::array<uint64_t, kNumDistinctActions> child_keys{};
+        std::array<int32_t, kNumDistinctActions> edge_visits{};
+    };
+
+    uint64_t Key(const CompactState &state, uint64_t parent_key, Action action) const;
+    Node &Expand(uint64_t key, const CompactState &state);
+    Action Select(const Node &node);
+    double Rollout(CompactState state);
+
+    std::shared_ptr<const Game> game_;
+    const RuleTable &rules_;
+    MctsOptions options_;
+    std::mt19937_64 rng_;
+    absl::flat_hash_map<uint64_t, Node> nodes_;
+};
+
+}  // namespace counter_air
+}  // namespace open_spiel
+
+#endif  // OPEN_SPIEL_GAMES_COUNTER_AIR_MCTS_H_
@@ -0,0 +1,79 @@
+// Copyright 2019 DeepMind Technologies Limited
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "open_spiel/games/counter_air_mcts.h"
+
+#include <memory>
+
+#include "open_spiel/games/counter_air.h"
+#include "open_spiel/games/counter_air_solve_job.h"
+#include "open_spiel/spiel.h"
+#include "open_spiel/spiel_utils.h"
+
+namespace open_spiel {
+namespace counter_air {
+namespace {
+
+std::shared_ptr<const Game> SmallGame() {
+  return LoadGame("counter_air", {{"blue_fighters", GameParameter(2)},
+                                  {"red_fighters", GameParameter(1)},
+                                  {"red_sams", GameParameter(1)},
+                                  {"num_waves", GameParameter(1)},
+                                  {"num_aaa", GameParameter(1)},
+                                  {"hit_threshold", GameParameter(2)}});
+}
+
+void DagSharesNodesTest() {
+  std::shared_ptr<const Game> game = SmallGame();
+  std::unique_ptr<State> state = game->NewInitialState();
+  const auto& root = static_cast<const CounterAirState&>(*state);
+  MctsOptions options;
+  options.num_simulations = 20000;
+  options.dag = false;
+  CounterAirMcts tree(game, options);
+  const MctsResult tree_result = tree.Search(root);
+  options.dag = true;
+  CounterAirMcts dag(game, options);
+  const MctsResult dag_result = dag.Search(root);
+  SPIEL_CHECK_LT(dag.num_nodes(), tree.num_nodes());
+  SPIEL_CHECK_EQ(tree_result.simulations, options.num_simulations);
+  SPIEL_CHECK_EQ(dag_result.simulations, options.num_simulations);
+
+  // Further searches reuse the nodes.
+  dag.Search(root);
+  SPIEL_CHECK_EQ(dag.Search(root).simulations, 3 * options.num_simulations);
+}
+
+// With enough simulations the search finds the exact value.
+void ConvergesTest() {
+  std::shared_ptr<const Game> game = SmallGame();
+  CounterAirSolveJob solve(game, SolveJobOptions());
+  SPIEL_CHECK_TRUE(solve.Run());
+  std::unique_ptr<State> state = game->NewInitialState();
+  const auto& root = static_cast<const CounterAirState&>(*state);
+  MctsOptions options;
+  options.num_simulations = 200000;
+  CounterAirMcts mcts(game, options);
+  const MctsResult result = mcts.Search(root);
+  SPIEL_CHECK_FLOAT_NEAR(result.value, solve.Value(root), 0.1);
+}
+
+}  // namespace
+}  // namespace counter_air
+}  // namespace open_spiel
+
+int main(int argc, char** argv) {
+  open_spiel::counter_air::DagSharesNodesTest();
+  open_spiel::counter_air::ConvergesTest();
+}
@@ -0,0 +1,173 @@
+// Copyright 2019 DeepMind Technologies Limited
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "open_spiel/games/counter_air_opening_book.h"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "open_spiel/spiel_utils.h"
+
+namespace open_spiel {
+namespace counter_air {
+namespace {
+
+constexpr char kBookMagic[8] = {'C', 'A', 'B', 'O', 'O', 'K', '0', '1'};
+constexpr int kLastPlacementPhase = 4;
+static_assert(sizeof(OpeningBookEntry) == 16, "Book entries are 16 bytes");
+
+bool IsPlacementNode(const CounterAirState &state) {
+    return !state.IsTerminal() && state.current_wave_ == 0 &&
+           state.current_phase_ <= kLastPlacementPhase;
+}
+
+// Minimax over the placement tree. Appends one entry per placement node.
+double SearchPlacements(const CounterAirState &state,
+                        const LeafEvaluator &evaluator,
+                        std::vector<OpeningBookEntry> *entries) {
+    if (!IsPlacementNode(state)) {
+        return evaluator(state);
+    }
+    const bool maximising = state.CurrentPlayer() == 0;
+    double best_value = maximising ? -2 : 2;
+    Action best_action = kInvalidAction;
+    for (Action action : state.LegalActions()) {
+        CounterAirState child(state);
+        child.ApplyAction(action);
+        double value = SearchPlacements(child, evaluator, entries);
+        if (maximising ? value > best_value : value < best_value) {
+            best_value = value;
+            best_action = action;
+        }
+    }
+    OpeningBookEntry entry{};
+    entry.key = state.StateKey();
+    entry.value = best_value;
+    entry.action = best_action;
+    entries->push_back(entry);
+    return best_value;
+}
+
+}  // namespace
+
+double RandomRolloutValue(const CounterAirState &state, int num_rollouts,
+                          std::mt19937 *rng) {
+    SPIEL_CHECK_GT(num_rollouts, 0);
+    double total = 0;
+    for (int i = 0; i < num_rollouts; i++) {
+        CounterAirState rollout(state);
+        while (!rollout.IsTerminal()) {
+            std::vector<Action> actions = rollout.LegalActions();
+            std::uniform_int_distribution<int> dist(0, actions.size() - 1);
+            rollout.ApplyAction(actions[dist(*rng)]);
+        }
+        total += rollout.Returns()[0];
+    }
+    return total / num_rollouts;
+}
+
+OpeningBook::OpeningBook(std::vector<OpeningBookEntry> entries)
+    : entries_(std::move(entries)) {
+    std::sort(entries_.begin(), entries_.end(),
+              [](const OpeningBookEntry &a, const OpeningBookEntry &b) {
+                  return a.key < b.key;
+              });
+}
+
+OpeningBook OpeningBook::Build(const Game &game,
+                               const OpeningBookOptions &options) {
+    std::mt19937 rng(options.seed);
+    LeafEvaluator evaluator = options.evaluator;
+    if (!evaluator) {
+        evaluator = [&rng, &options](const CounterAirState &state) {
+            return RandomRolloutValue(state, options.rollouts_per_leaf, &rng);
+        };
+    }
+    std::unique_ptr<State> root = game.NewInitialState();
+    std::vector<OpeningBookEntry> entries;
+    SearchPlacements(static_cast<const CounterAirState &>(*root), evaluator,
+                     &entries);
+    return OpeningBook(std::move(entries));
+}
+
+OpeningBook OpeningBook::Load(const std::string &path) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in) {
+        SpielFatalError(absl::StrCat("Could not open opening book ", path));
+    }
+    char magic[sizeof(kBookMagic)];
+    uint64_t num_entries = 0;
+    in.read(magic, sizeof(magic));
+    in.read(reinterpret_cast<char *>(&num_entries), sizeof(num_entries));
+    if (!in || std::memcmp(magic, kBookMagic, sizeof(kBookMagic)) != 0) {
+        SpielFatalError(absl::StrCat("Not a counter_air opening book: ", path));
+    }
+    // Check the count against the file size before allocating for it.
+    const std::streamoff header_size = in.tellg();
+    in.seekg(0, std::ios::end);
+    const uint64_t data_size = static_cast<uint64_t>(in.tellg() - header_size);
+    if (!in || data_size % sizeof(OpeningBookEntry) != 0 ||
+        data_size / sizeof(OpeningBookEntry) != num_entries) {
+        SpielFatalError(absl::StrCat("Opening book ", path, " does not hold the ",
+                                     num_entries, " entries its header counts"));
+    }
+    in.seekg(header_size);
+    std::vector<OpeningBookEntry> entries(num_entries);
+    in.read(reinterpret_cast<char *>(entries.data()),
+            num_entries * sizeof(OpeningBookEntry));
+    if (!in) {
+        SpielFatalError(absl::StrCat("Truncated opening book ", path));
+    }
+    // Find() relies on the order.
+    if (!std::is_sorted(entries.begin(), entries.end(),
+                        [](const OpeningBookEntry &a, const OpeningBookEntry &b) {
+                            return a.key < b.key;
+                        })) {
+        SpielFatalError(absl::StrCat("Opening book ", path, " is not sorted by key"));
+    }
+    return OpeningBook(std::move(entries));
+}
+
+void OpeningBook::Save(const std::string &path) const {
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    uint64_t num_entries = entries_.size();
+    out.write(kBookMagic, sizeof(kBookMagic));
+    out.write(reinterpret_cast<const char *>(&num_entries), sizeof(num_entries));
+    out.write(reinterpret_cast<const char *>(entries_.data()),
+              num_entries * sizeof(OpeningBookEntry));
+    if (!out) {
+        SpielFatalError(absl::StrCat("Could not write opening book ", path));
+    }
+}
+
+const OpeningBookEntry *OpeningBook::Find(uint64_t key) const {
+    auto it = std::lower_bound(
+        entries_.begin(), entries_.end(), key,
+        [](const OpeningBookEntry &entry, uint64_t k) { return entry.key < k; });
+    if (it == entries_.end() || it->key != key) return nullptr;
+    return &*it;
+}
+
+Action OpeningBook::Lookup(const CounterAirState &state) const {
+    if (!IsPlacementNode(state)) return kInvalidAction;
+    const OpeningBookEntry *entry = Find(state.StateKey());
+    return entry == nullptr ? kInvalidAction : entry->action;
+}
+
+}  // namespace counter_air
+}  // namespace open_spiel
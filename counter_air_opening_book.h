@@ -0,0 +1,86 @@
+// Copyright 2019 DeepMind Technologies Limited
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef OPEN_SPIEL_GAMES_COUNTER_AIR_OPENING_BOOK_H_
+#define OPEN_SPIEL_GAMES_COUNTER_AIR_OPENING_BOOK_H_
+
+#include <cstdint>
+#include <functional>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "open_spiel/games/counter_air.h"
+#include "open_spiel/spiel.h"
+
+// Opening book for the wave-0 placement phases (0-4). Every placement node is
+// searched offline: the leaves (the first state of phase 5) are scored by a
+// leaf evaluator and the values are backed up by minimax, Blue maximising and
+// Red minimising Blue's return. The book stores the best action and value of
+// every placement node, keyed by CounterAirState::StateKey().
+//
+// File format: the 8-byte magic "CABOOK01", a uint64 entry count, and then the
+// entries sorted by key.
+
+namespace open_spiel {
+namespace counter_air {
+
+struct OpeningBookEntry {
+    uint64_t key;
+    float value;  // Expected return for Blue.
+    uint8_t action;
+    uint8_t padding[3];
+};
+
+// Scores a leaf of the placement tree from Blue's point of view, in [-1, 1].
+using LeafEvaluator = std::function<double(const CounterAirState &)>;
+
+struct OpeningBookOptions {
+    int rollouts_per_leaf = 100;
+    int seed = 0;
+    // Overrides the random-rollout leaf evaluator when set.
+    LeafEvaluator evaluator;
+};
+
+class OpeningBook {
+   public:
+    OpeningBook() = default;
+
+    // Searches every wave-0 placement of `game` and returns the book.
+    static OpeningBook Build(const Game &game, const OpeningBookOptions &options);
+    static OpeningBook Load(const std::string &path);
+    void Save(const std::string &path) const;
+
+    // The entry stored under `key`, or nullptr if there is none.
+    const OpeningBookEntry *Find(uint64_t key) const;
+    // Returns kInvalidAction when the state is not in the book.
+    Action Lookup(const CounterAirState &state) const;
+
+    int size() const { return entries_.size(); }
+    const std::vector<OpeningBookEntry> &entries() const { return entries_; }
+
+   private:
+    explicit OpeningBook(std::vector<OpeningBookEntry> entries);
+
+    std::vector<OpeningBookEntry> entries_;  // Sorted by key.
+};
+
+// Mean Blue return of `num_rollouts` uniformly random playouts from `state`.
+double RandomRolloutValue(const CounterAirState &state, int num_rollouts,
+                          std::mt19937 *rng);
+
+}  // namespace counter_air
+}  // namespace open_spiel
+
+#endif  // OPEN_SPIEL_GAMES_COUNTER_AIR_OPENING_BOOK_H_
@@ -0,0 +1,42 @@
+// Copyright 2019 DeepMind Technologies Limited
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Searches all wave-0 placements of counter_air and writes the opening book.
+
+#include <iostream>
+#include <string>
+
+#include "absl/flags/flag.h"
+#include "absl/flags/parse.h"
+#include "open_spiel/games/counter_air_opening_book.h"
+#include "open_spiel/spiel.h"
+
+ABSL_FLAG(std::string, output, "counter_air_book.bin", "Output book file.");
+ABSL_FLAG(int, rollouts_per_leaf, 1000, "Random playouts per placement leaf.");
+ABSL_FLAG(int, seed, 0, "Seed for the rollouts.");
+
+int main(int argc, char** argv) {
+    absl::ParseCommandLine(argc, argv);
+    open_spiel::counter_air::OpeningBookOptions options;
+    options.rollouts_per_leaf = absl::GetFlag(FLAGS_rollouts_per_leaf);
+    options.seed = absl::GetFlag(FLAGS_seed);
+
+    std::shared_ptr<const open_spiel::Game> game =
+        open_spiel::LoadGame("counter_air");
+    open_spiel::counter_air::OpeningBook book =
+        open_spiel::counter_air::OpeningBook::Build(*game, options);
+    book.Save(absl::GetFlag(FLAGS_output));
+    std::cout << "Wrote " << book.size() << " placement nodes to "
+              << absl::GetFlag(FLAGS_output) << std::endl;
+}
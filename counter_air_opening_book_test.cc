@@ -0,0 +1,87 @@
+// Copyright 2019 DeepMind Technologies Limited
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "open_spiel/games/counter_air_opening_book.h"
+
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <string>
+
+#include "open_spiel/spiel.h"
+#include "open_spiel/spiel_utils.h"
+
+namespace open_spiel {
+namespace counter_air {
+namespace {
+
+// Blue is rewarded for keeping fighters out of the escort box.
+double EscortPenalty(const CounterAirState& state) {
+  return -state.board_[0] / 10.0;
+}
+
+void BuildAndLookupTest() {
+  std::shared_ptr<const Game> game = LoadGame("counter_air");
+  OpeningBookOptions options;
+  options.evaluator = EscortPenalty;
+  OpeningBook book = OpeningBook::Build(*game, options);
+  // 1 + 11 + 66 Blue nodes and 286 + 286 * 5 Red nodes.
+  SPIEL_CHECK_EQ(book.size(), 1794);
+
+  std::unique_ptr<State> state = game->NewInitialState();
+  const auto& root = static_cast<const CounterAirState&>(*state);
+  SPIEL_CHECK_EQ(book.Lookup(root), 0);
+  SPIEL_CHECK_EQ(book.Find(root.StateKey())->value, 0);
+
+  // Follow the book through the whole placement.
+  while (root.current_phase_ <= 4) {
+    Action action = book.Lookup(root);
+    std::vector<Action> legal = state->LegalActions();
+    SPIEL_CHECK_TRUE(std::find(legal.begin(), legal.end(), action) !=
+                     legal.end());
+    state->ApplyAction(action);
+  }
+  SPIEL_CHECK_EQ(book.Lookup(root), kInvalidAction);
+}
+
+void SaveLoadTest() {
+  std::shared_ptr<const Game> game = LoadGame("counter_air");
+  OpeningBookOptions options;
+  options.rollouts_per_leaf = 1;
+  OpeningBook book = OpeningBook::Build(*game, options);
+  char path[] = "/tmp/counter_air_opening_book_test.XXXXXX";
+  const int fd = mkstemp(path);
+  SPIEL_CHECK_GE(fd, 0);
+  close(fd);
+  book.Save(path);
+  OpeningBook loaded = OpeningBook::Load(path);
+  SPIEL_CHECK_EQ(unlink(path), 0);
+  SPIEL_CHECK_EQ(loaded.size(), book.size());
+  for (const OpeningBookEntry& entry : book.entries()) {
+    const OpeningBookEntry* other = loaded.Find(entry.key);
+    SPIEL_CHECK_TRUE(other != nullptr);
+    SPIEL_CHECK_EQ(other->action, entry.action);
+    SPIEL_CHECK_EQ(other->value, entry.value);
+  }
+}
+
+}  // namespace
+}  // namespace counter_air
+}  // namespace open_spiel
+
+int main(int argc, char** argv) {
+  open_spiel::counter_air::BuildAndLookupTest();
+  open_spiel::counter_air::SaveLoadTest();
+}
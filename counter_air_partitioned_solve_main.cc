@@ -0,0 +1,162 @@
+// Copyright 2019 DeepMind Technologies Limited
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Runs an exact solve of counter_air partitioned over worker processes that
+// talk over Unix-domain sockets in --socket_dir. With --role=local the
+// coordinator forks the workers itself, in a fresh temporary directory unless
+// --socket_dir is given; with --role=worker or coordinator each process is
+// started separately, e.g. by a job launcher, and all must be given the same
+// --socket_dir. The transports replace any "<rank>.sock" in it, so it should
+// be a directory of the job's own.
+
+#include <signal.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "absl/flags/flag.h"
+#include "absl/flags/parse.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/str_format.h"
+#include "absl/time/time.h"
+#include "open_spiel/games/counter_air.h"
+#include "open_spiel/games/counter_air_partitioned_solver.h"
+#include "open_spiel/games/counter_air_transport.h"
+#include "open_spiel/spiel.h"
+
+ABSL_FLAG(std::string, game, "counter_air", "Game string, with its parameters.");
+ABSL_FLAG(std::string, role, "local", "local, coordinator or worker.");
+ABSL_FLAG(int, num_workers, 4, "Worker processes.");
+ABSL_FLAG(int, rank, 0, "Rank of this worker, for --role=worker.");
+ABSL_FLAG(std::string, socket_dir, "",
+          "Directory of the sockets; required unless --role=local.");
+ABSL_FLAG(int, batch_size, 1024, "Records per message.");
+ABSL_FLAG(int, progress_seconds, 30, "Seconds between progress lines.");
+ABSL_FLAG(int, reply_timeout_seconds, 300,
+          "Seconds the coordinator waits on unresponsive workers before failing.");
+
+int main(int argc, char** argv) {
+    absl::ParseCommandLine(argc, argv);
+    namespace ca = open_spiel::counter_air;
+    std::shared_ptr<const open_spiel::Game> game =
+        open_spiel::LoadGame(absl::GetFlag(FLAGS_game));
+    const std::string role = absl::GetFlag(FLAGS_role);
+    std::string dir = absl::GetFlag(FLAGS_socket_dir);
+    const int num_workers = absl::GetFlag(FLAGS_num_workers);
+    if (role != "local" && role != "worker" && role != "coordinator") {
+        std::cerr << "Unknown --role " << role << "\n";
+        return 1;
+    }
+    const bool own_dir = dir.empty();
+    if (own_dir) {
+        if (role != "local") {
+            std::cerr << "--role=" << role << " needs --socket_dir\n";
+            return 1;
+        }
+        char tmp_dir[] = "/tmp/counter_air_partitioned_solve.XXXXXX";
+        if (mkdtemp(tmp_dir) == nullptr) {
+            std::cerr << "Could not create a socket directory\n";
+            return 1;
+        }
+        dir = tmp_dir;
+    }
+
+    ca::PartitionedSolveOptions options;
+    options.batch_size = absl::GetFlag(FLAGS_batch_size);
+    options.progress_interval = absl::Seconds(absl::GetFlag(FLAGS_progress_seconds));
+    options.reply_timeout = absl::Seconds(absl::GetFlag(FLAGS_reply_timeout_seconds));
+
+    if (role == "worker") {
+        ca::UnixSocketTransport transport(dir, absl::GetFlag(FLAGS_rank), num_workers + 1);
+        ca::RunPartitionWorker(game, &transport, options);
+        return 0;
+    }
+
+    // Worker pids by rank; -1 once reaped.
+    std::vector<pid_t> children;
+    auto stop_workers = [&]() {
+        for (pid_t child : children) {
+            if (child > 0) kill(child, SIGTERM);
+        }
+        for (pid_t child : children) {
+            if (child > 0) waitpid(child, nullptr, 0);
+        }
+        // Killed workers leave their sockets behind.
+        if (own_dir) {
+            for (int rank = 0; rank <= num_workers; rank++) {
+                unlink(absl::StrCat(dir, "/", rank, ".sock").c_str());
+            }
+            rmdir(dir.c_str());
+        }
+    };
+    if (role == "local") {
+        for (int rank = 0; rank < num_workers; rank++) {
+            const pid_t pid = fork();
+            if (pid < 0) {
+                std::cerr << "Could not start worker " << rank << "\n";
+                stop_workers();
+                return 1;
+            }
+            if (pid == 0) {
+                {
+                    // Destroyed before _exit, which would skip it, to remove
+                    // the socket.
+                    ca::UnixSocketTransport transport(dir, rank, num_workers + 1);
+                    ca::RunPartitionWorker(game, &transport, options);
+                }
+                _exit(0);
+            }
+            children.push_back(pid);
+        }
+        // Workers only exit when shut down, so one that exits during the
+        // solve has failed and the solve cannot finish.
+        options.check_workers = [&]() {
+            for (int rank = 0; rank < num_workers; rank++) {
+                int status;
+                if (waitpid(children[rank], &status, WNOHANG) != children[rank]) continue;
+                children[rank] = -1;
+                stop_workers();
+                open_spiel::SpielFatalError(absl::StrCat(
+                    "Worker ", rank, " ",
+                    WIFSIGNALED(status) ? absl::StrCat("was killed by signal ", WTERMSIG(status))
+                                        : absl::StrCat("exited with status ",
+                                                       WEXITSTATUS(status))));
+            }
+        };
+    }
+    {
+        ca::UnixSocketTransport transport(dir, num_workers, num_workers + 1);
+        ca::PartitionedSolveCoordinator coordinator(game, &transport, options);
+        const ca::SolvedState root =
+            coordinator.Solve([](const ca::PartitionedSolveProgress &progress) {
+                std::cout << absl::StrFormat(
+                                 "%.0fs: %d states, %d solved, %d records, round %d\n",
+                                 absl::ToDoubleSeconds(progress.elapsed), progress.num_states,
+                                 progress.solved_states, progress.records, progress.rounds)
+                          << std::flush;
+            });
+        coordinator.Shutdown();
+        std::cout << absl::StrFormat("Value %d, best opening action %d\n", root.value,
+                                     root.best_action);
+    }
+    for (pid_t pid : children) {
+        if (pid > 0) waitpid(pid, nullptr, 0);
+    }
+    if (own_dir) rmdir(dir.c_str());
+}
@@ -0,0 +1,437 @@
+// Copyright 2019 DeepMind Technologies Limited
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "open_spiel/games/counter_air_partitioned_solver.h"
+
+#include <algorithm>
+#include <cstring>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "absl/container/flat_hash_map.h"
+#include "absl/strings/str_cat.h"
+#include "absl/time/clock.h"
+#include "open_spiel/games/counter_air_rules.h"
+#include "open_spiel/spiel_utils.h"
+
+namespace open_spiel {
+namespace counter_air {
+namespace {
+
+// A message is its type byte followed by an array of records.
+enum MessageType : uint8_t {
+    kVisits = 1,     // VisitRecord[], to the owner of each state.
+    kValues,         // ValueRecord[], to the owner of each parent.
+    kStatusRequest,  // int32 round, to the workers.
+    kStatus,         // StatusReport, to the coordinator.
+    kQuery,          // uint64 key, to the owner.
+    kQueryReply,     // QueryReply, to the coordinator.
+    kShutdown,
+};
+
+struct VisitRecord {
+    CompactState state;
+    uint64_t key;
+    uint64_t parent_key;
+    int8_t action;  // kInvalidAction for the initial state.
+};
+
+struct ValueRecord {
+    uint64_t key;  // Of the parent.
+    int8_t action;
+    int8_t value;
+};
+
+struct StatusReport {
+    int32_t round;
+    int64_t sent;
+    int64_t received;
+    int64_t num_states;
+    int64_t solved_states;
+};
+
+struct QueryReply {
+    uint64_t key;
+    int32_t found;
+    SolvedState solved;
+};
+
+template <typename T>
+std::string Encode(MessageType type, const T *records, size_t count) {
+    static_assert(std::is_trivially_copyable<T>::value, "Records are sent as bytes");
+    std::string message(1 + count * sizeof(T), '\0');
+    message[0] = type;
+    if (count > 0) std::memcpy(&message[1], records, count * sizeof(T));
+    return message;
+}
+
+template <typename T>
+std::vector<T> Decode(const std::string &message) {
+    SPIEL_CHECK_EQ((message.size() - 1) % sizeof(T), 0);
+    std::vector<T> records((message.size() - 1) / sizeof(T));
+    if (!records.empty()) std::memcpy(records.data(), &message[1], records.size() * sizeof(T));
+    return records;
+}
+
+MessageType TypeOf(const std::string &message) {
+    SPIEL_CHECK_FALSE(message.empty());
+    return static_cast<MessageType>(message[0]);
+}
+
+int8_t TerminalValue(const CompactState &state) {
+    if (state.outcome == 0) return 1;
+    if (state.outcome == 1) return -1;
+    return 0;
+}
+
+class PartitionWorker {
+   public:
+    PartitionWorker(std::shared_ptr<const Game> game, SolverTransport *transport,
+                    const PartitionedSolveOptions &options)
+        : game_(game),
+          rules_(static_cast<const CounterAirGame &>(*game).rules()),
+          transport_(transport),
+          batch_size_(options.batch_size),
+          num_workers_(transport->num_endpoints() - 1),
+          out_visits_(num_workers_),
+          out_values_(num_workers_) {
+        SPIEL_CHECK_GE(num_workers_, 1);
+        SPIEL_CHECK_LT(transport->rank(), num_workers_);
+    }
+
+    int64_t Run() {
+        std::string message;
+        while (!shutdown_) {
+            ProcessLocal();
+            const bool buffered = buffered_ > 0;
+            if (!transport_->Receive(&message, buffered ? absl::ZeroDuration()
+                                                        : absl::Milliseconds(10))) {
+                // Nothing arrived: send what we have rather than wait for full
+                // batches.
+                if (buffered) FlushAll();
+                continue;
+            }
+            Handle(message);
+        }
+        return table_.size();
+    }
+
+   private:
+    struct ParentEdge {
+        uint64_t key;
+        int8_t action;
+    };
+
+    struct Entry {
+        int8_t player;
+        int8_t best_value;
+        int8_t best_action;
+        uint8_t pending;  // Children yet to report; the state is solved at 0.
+        std::vector<ParentEdge> parents;  // Waiting for the value.
+    };
+
+    void Handle(const std::string &message) {
+        switch (TypeOf(message)) {
+            case kVisits:
+                for (const VisitRecord &record : Decode<VisitRecord>(message)) {
+                    received_++;
+                    Visit(record);
+                }
+                break;
+            case kValues:
+                for (const ValueRecord &record : Decode<ValueRecord>(message)) {
+                    received_++;
+                    Report(record);
+                }
+                break;
+            case kStatusRequest: {
+                FlushAll();
+                StatusReport report = {};
+                std::memcpy(&report.round, &message[1], sizeof(report.round));
+                report.sent = sent_;
+                report.received = received_;
+                report.num_states = table_.size();
+                report.solved_states = solved_;
+                transport_->Send(num_workers_, Encode(kStatus, &report, 1));
+                break;
+            }
+            case kQuery: {
+                QueryReply reply = {};
+                std::memcpy(&reply.key, &message[1], sizeof(reply.key));
+                auto it = table_.find(reply.key);
+                reply.found = it != table_.end() && it->second.pending == 0;
+                if (reply.found) {
+                    reply.solved = {it->second.best_value, it->second.best_action};
+                }
+                transport_->Send(num_workers_, Encode(kQueryReply, &reply, 1));
+                break;
+            }
+            case kShutdown:
+                shutdown_ = true;
+                break;
+            default:
+                SpielFatalError("Unexpected message type");
+        }
+    }
+
+    void ProcessLocal() {
+        std::vector<VisitRecord> visits;
+        std::vector<ValueRecord> values;
+        while (!local_visits_.empty() || !local_values_.empty()) {
+            visits.swap(local_visits_);
+            values.swap(local_values_);
+            for (const VisitRecord &record : visits) Visit(record);
+            for (const ValueRecord &record : values) Report(record);
+            visits.clear();
+            values.clear();
+        }
+    }
+
+    void Visit(const VisitRecord &record) {
+        auto [it, inserted] = table_.try_emplace(record.key);
+        Entry &entry = it->second;
+        if (inserted) Expand(record, &entry);
+        if (record.action == kInvalidAction) return;
+        const ParentEdge edge = {record.parent_key, record.action};
+        if (entry.pending == 0) {
+            SendValue(edge, entry.best_value);
+        } else {
+            entry.parents.push_back(edge);
+        }
+    }
+
+    // Terminal children are scored here; the others are visited on their
+    // owners and report back.
+    void Expand(const VisitRecord &record, Entry *entry) {
+        entry->player = record.state.current_player;
+        entry->best_value = entry->player == 0 ? -2 : 2;
+        entry->best_action = kInvalidAction;
+        entry->pending = 0;
+        const uint16_t legal = RuleLegalMask(rules_, record.state);
+        for (int action = 0; action < kNumDistinctActions; action++) {
+            if (!(legal & (1 << action))) continue;
+            CompactState child = record.state;
+            RuleApplyAction(rules_, &child, action);
+            if (RuleIsTerminal(rules_, child)) {
+                Improve(entry, action, TerminalValue(child));
+                continue;
+            }
+            VisitRecord visit = {};
+            visit.state = child;
+            visit.key = CanonicalStateKey(child);
+            visit.parent_key = record.key;
+            visit.action = action;
+            const int owner = PartitionOwner(visit.key, num_workers_);
+            if (owner == transport_->rank()) {
+                local_visits_.push_back(visit);
+            } else {
+                out_visits_[owner].push_back(visit);
+                buffered_++;
+                if (out_visits_[owner].size() >= batch_size_) Flush(owner);
+            }
+            entry->pending++;
+        }
+        if (entry->pending == 0) solved_++;
+    }
+
+    void Report(const ValueRecord &record) {
+        auto it = table_.find(record.key);
+        SPIEL_CHECK_TRUE(it != table_.end());
+        Entry &entry = it->second;
+        SPIEL_CHECK_GT(entry.pending, 0);
+        Improve(&entry, record.action, record.value);
+        if (--entry.pending > 0) return;
+        solved_++;
+        for (const ParentEdge &edge : entry.parents) SendValue(edge, entry.best_value);
+        std::vector<ParentEdge>().swap(entry.parents);
+    }
+
+    // Values arrive in any order; ties go to the lowest action, as in the
+    // single-process solve.
+    static void Improve(Entry *entry, int action, int8_t value) {
+        const bool better =
+            entry->player == 0 ? value > entry->best_value : value < entry->best_value;
+        if (better || (value == entry->best_value && action < entry->best_action)) {
+            entry->best_value = value;
+            entry->best_action = action;
+        }
+    }
+
+    void SendValue(const ParentEdge &edge, int8_t value) {
+        const ValueRecord record = {edge.key, edge.action, value};
+        const int owner = PartitionOwner(edge.key, num_workers_);
+        if (owner == transport_->rank()) {
+            local_values_.push_back(record);
+            return;
+        }
+        out_values_[owner].push_back(record);
+        buffered_++;
+        if (out_values_[owner].size() >= batch_size_) Flush(owner);
+    }
+
+    void Flush(int to) {
+        std::vector<VisitRecord> &visits = out_visits_[to];
+        std::vector<ValueRecord> &values = out_values_[to];
+        if (!visits.empty()) {
+            transport_->Send(to, Encode(kVisits, visits.data(), visits.size()));
+            sent_ += visits.size();
+            buffered_ -= visits.size();
+            visits.clear();
+        }
+        if (!values.empty()) {
+            transport_->Send(to, Encode(kValues, values.data(), values.size()));
+            sent_ += values.size();
+            buffered_ -= values.size();
+            values.clear();
+        }
+    }
+
+    void FlushAll() {
+        for (int to = 0; to < num_workers_; to++) Flush(to);
+    }
+
+    std::shared_ptr<const Game> game_;
+    const RuleTable &rules_;
+    SolverTransport *transport_;
+    size_t batch_size_;
+    int num_workers_;
+    absl::flat_hash_map<uint64_t, Entry> table_;
+    std::vector<VisitRecord> local_visits_;
+    std::vector<ValueRecord> local_values_;
+    std::vector<std::vector<VisitRecord>> out_visits_;
+    std::vector<std::vector<ValueRecord>> out_values_;
+    size_t buffered_ = 0;
+    int64_t sent_ = 0;
+    int64_t received_ = 0;
+    int64_t solved_ = 0;
+    bool shutdown_ = false;
+};
+
+}  // namespace
+
+int PartitionOwner(uint64_t key, int num_workers) {
+    return (key >> 32) % num_workers;
+}
+
+int64_t RunPartitionWorker(std::shared_ptr<const Game> game, SolverTransport *transport,
+                           const PartitionedSolveOptions &options) {
+    return PartitionWorker(game, transport, options).Run();
+}
+
+PartitionedSolveCoordinator::PartitionedSolveCoordinator(std::shared_ptr<const Game> game,
+                                                         SolverTransport *transport,
+                                                         PartitionedSolveOptions options)
+    : game_(game),
+      transport_(transport),
+      options_(std::move(options)),
+      num_workers_(transport->num_endpoints() - 1) {
+    SPIEL_CHECK_GE(num_workers_, 1);
+    SPIEL_CHECK_EQ(transport->rank(), num_workers_);
+}
+
+SolvedState PartitionedSolveCoordinator::Solve(
+    const std::function<void(const PartitionedSolveProgress &)> &progress) {
+    const absl::Time start = absl::Now();
+    absl::Time next_progress = start + options_.progress_interval;
+    std::unique_ptr<State> root = game_->NewInitialState();
+    VisitRecord visit = {};
+    visit.state = static_cast<const CounterAirState &>(*root).ToCompact();
+    visit.key = CanonicalStateKey(visit.state);
+    visit.action = kInvalidAction;
+    transport_->Send(PartitionOwner(visit.key, num_workers_), Encode(kVisits, &visit, 1));
+    const int64_t coordinator_sent = 1;
+
+    int64_t last_sent = -1;
+    int64_t last_received = -1;
+    std::string message;
+    for (int32_t round = 1;; round++) {
+        absl::SleepFor(options_.status_interval);
+        const std::string request = Encode(kStatusRequest, &round, 1);
+        for (int worker = 0; worker < num_workers_; worker++) transport_->Send(worker, request);
+
+        PartitionedSolveProgress totals;
+        int64_t received = 0;
+        totals.records = coordinator_sent;
+        const absl::Time deadline = absl::Now() + options_.reply_timeout;
+        for (int replies = 0; replies < num_workers_;) {
+            if (!ReceiveBefore(deadline, &message)) {
+                SpielFatalError(absl::StrCat("Only ", replies, " of ", num_workers_,
+                                             " workers answered status round ", round,
+                                             " within ",
+                                             absl::FormatDuration(options_.reply_timeout)));
+            }
+            SPIEL_CHECK_EQ(TypeOf(message), kStatus);
+            const StatusReport report = Decode<StatusReport>(message).at(0);
+            if (report.round != round) continue;
+            totals.records += report.sent;
+            totals.num_states += report.num_states;
+            totals.solved_states += report.solved_states;
+            received += report.received;
+            replies++;
+        }
+        totals.rounds = round;
+        totals.elapsed = absl::Now() - start;
+        progress_ = totals;
+        if (progress && absl::Now() >= next_progress) {
+            progress(progress_);
+            next_progress = absl::Now() + options_.progress_interval;
+        }
+        if (totals.records == received && totals.records == last_sent &&
+            received == last_received) {
+            break;
+        }
+        last_sent = totals.records;
+        last_received = received;
+    }
+    if (progress) progress(progress_);
+    return Query(static_cast<const CounterAirState &>(*root));
+}
+
+SolvedState PartitionedSolveCoordinator::Query(const CounterAirState &state) {
+    const uint64_t key = state.CanonicalKey();
+    transport_->Send(PartitionOwner(key, num_workers_), Encode(kQuery, &key, 1));
+    std::string message;
+    const absl::Time deadline = absl::Now() + options_.reply_timeout;
+    while (true) {
+        if (!ReceiveBefore(deadline, &message)) {
+            SpielFatalError(absl::StrCat("Worker ", PartitionOwner(key, num_workers_),
+                                         " did not answer a query within ",
+                                         absl::FormatDuration(options_.reply_timeout)));
+        }
+        if (TypeOf(message) != kQueryReply) continue;
+        const QueryReply reply = Decode<QueryReply>(message).at(0);
+        if (reply.key != key) continue;
+        SPIEL_CHECK_TRUE(reply.found);
+        return reply.solved;
+    }
+}
+
+bool PartitionedSolveCoordinator::ReceiveBefore(absl::Time deadline, std::string *message) {
+    while (true) {
+        const absl::Duration left = deadline - absl::Now();
+        if (left <= absl::ZeroDuration()) return false;
+        if (transport_->Receive(message, std::min(left, absl::Seconds(1)))) return true;
+        if (options_.check_workers) options_.check_workers();
+    }
+}
+
+void PartitionedSolveCoordinator::Shutdown() {
+    const std::string message(1, static_cast<char>(kShutdown));
+    for (int worker = 0; worker < num_workers_; worker++) transport_->Send(worker, message);
+}
+
+}  // namespace counter_air
+}  // namespace open_spiel
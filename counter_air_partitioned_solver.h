@@ -0,0 +1,106 @@
+// Copyright 2019 DeepMind Technologies Limited
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef OPEN_SPIEL_GAMES_COUNTER_AIR_PARTITIONED_SOLVER_H_
+#define OPEN_SPIEL_GAMES_COUNTER_AIR_PARTITIONED_SOLVER_H_
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+
+#include "absl/time/time.h"
+#include "open_spiel/games/counter_air.h"
+#include "open_spiel/games/counter_air_solve_job.h"
+#include "open_spiel/games/counter_air_transport.h"
+#include "open_spiel/spiel.h"
+
+// Exact solve of counter_air split over worker processes, for state spaces
+// that do not fit one machine's memory or time budget. The state space is
+// partitioned by CanonicalStateKey(): worker PartitionOwner(key) holds the
+// state and its solution. The transport has num_workers + 1 endpoints;
+// workers are ranks 0 .. num_workers - 1 and the coordinator is the last.
+//
+// The solve is a single asynchronous pass. Visiting a state for the first
+// time expands it and sends a visit to the owner of each child; a visit also
+// records its parent edge. A state whose children have all reported is
+// solved, and reports its value to each recorded parent, as well as to
+// parents that reach it later. Records to other workers are batched per
+// destination. The coordinator detects termination by polling each worker's
+// counts of records sent and received: once two consecutive rounds return the
+// same totals with sent equal to received, no record is in flight and no
+// worker has work left.
+
+namespace open_spiel {
+namespace counter_air {
+
+int PartitionOwner(uint64_t key, int num_workers);
+
+struct PartitionedSolveOptions {
+    int batch_size = 1024;  // Records per message.
+    absl::Duration status_interval = absl::Milliseconds(20);
+    absl::Duration progress_interval = absl::Seconds(30);
+    // The coordinator fails the solve if the workers leave a status round or
+    // a query unanswered for this long.
+    absl::Duration reply_timeout = absl::Minutes(5);
+    // Called by the coordinator after each second it waits on the workers
+    // without a message, e.g. to check that they are still running; it may
+    // fail the solve.
+    std::function<void()> check_workers;
+};
+
+struct PartitionedSolveProgress {
+    int64_t num_states = 0;  // Visited, over all workers.
+    int64_t solved_states = 0;
+    int64_t records = 0;  // Sent between endpoints.
+    int rounds = 0;       // Of termination detection.
+    absl::Duration elapsed;
+};
+
+// Serves its partition until the coordinator shuts the solve down. Returns
+// the number of states it held.
+int64_t RunPartitionWorker(std::shared_ptr<const Game> game, SolverTransport *transport,
+                           const PartitionedSolveOptions &options);
+
+class PartitionedSolveCoordinator {
+   public:
+    PartitionedSolveCoordinator(std::shared_ptr<const Game> game, SolverTransport *transport,
+                                PartitionedSolveOptions options);
+
+    // Solves every state reachable from the initial state; returns the
+    // solution of the initial state.
+    SolvedState Solve(
+        const std::function<void(const PartitionedSolveProgress &)> &progress = nullptr);
+    // Looks a solved state up on its owner.
+    SolvedState Query(const CounterAirState &state);
+    // Stops the workers.
+    void Shutdown();
+
+    const PartitionedSolveProgress &progress() const { return progress_; }
+
+   private:
+    // Returns false if no message arrives before `deadline`.
+    bool ReceiveBefore(absl::Time deadline, std::string *message);
+
+    std::shared_ptr<const Game> game_;
+    SolverTransport *transport_;
+    PartitionedSolveOptions options_;
+    int num_workers_;
+    PartitionedSolveProgress progress_;
+};
+
+}  // namespace counter_air
+}  // namespace open_spiel
+
+#endif  // OPEN_SPIEL_GAMES_COUNTER_AIR_PARTITIONED_SOLVER_H_
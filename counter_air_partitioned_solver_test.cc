@@ -0,0 +1,148 @@
+// Copyright 2019 DeepMind Technologies Limited
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "open_spiel/games/counter_air_partitioned_solver.h"
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <cstdlib>
+#include <memory>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "open_spiel/games/counter_air.h"
+#include "open_spiel/games/counter_air_solve_job.h"
+#include "open_spiel/games/counter_air_transport.h"
+#include "open_spiel/spiel.h"
+#include "open_spiel/spiel_utils.h"
+
+namespace open_spiel {
+namespace counter_air {
+namespace {
+
+std::shared_ptr<const Game> SmallGame() {
+  return LoadGame("counter_air",
+                  {{"blue_fighters", GameParameter(2)},
+                   {"red_fighters", GameParameter(1)},
+                   {"red_sams", GameParameter(1)},
+                   {"num_waves", GameParameter(1)},
+                   {"num_aaa", GameParameter(1)},
+                   {"hit_threshold", GameParameter(2)}});
+}
+
+void InProcessTest() {
+  std::shared_ptr<const Game> game = SmallGame();
+  CounterAirSolveJob job(game, SolveJobOptions());
+  SPIEL_CHECK_TRUE(job.Run());
+
+  constexpr int kNumWorkers = 3;
+  PartitionedSolveOptions options;
+  options.batch_size = 64;
+  std::vector<std::unique_ptr<SolverTransport>> transports =
+      MakeInProcessTransports(kNumWorkers + 1);
+  std::vector<std::thread> workers;
+  std::vector<int64_t> worker_states(kNumWorkers);
+  for (int rank = 0; rank < kNumWorkers; rank++) {
+    workers.emplace_back([&, rank]() {
+      worker_states[rank] =
+          RunPartitionWorker(game, transports[rank].get(), options);
+    });
+  }
+  PartitionedSolveCoordinator coordinator(game, transports[kNumWorkers].get(),
+                                          options);
+  const SolvedState root = coordinator.Solve();
+  SPIEL_CHECK_EQ(coordinator.progress().num_states, job.num_states());
+  SPIEL_CHECK_EQ(coordinator.progress().solved_states, job.num_states());
+
+  // Every state on random playouts has the single-process solution.
+  std::unique_ptr<State> initial = game->NewInitialState();
+  const auto& initial_state = static_cast<const CounterAirState&>(*initial);
+  SPIEL_CHECK_EQ(root.value, job.Value(initial_state));
+  SPIEL_CHECK_EQ(root.best_action, job.BestAction(initial_state));
+  std::mt19937 rng(7);
+  for (int game_index = 0; game_index < 50; game_index++) {
+    std::unique_ptr<State> state = game->NewInitialState();
+    while (!state->IsTerminal()) {
+      const auto& counter_air_state = static_cast<const CounterAirState&>(*state);
+      const SolvedState solved = coordinator.Query(counter_air_state);
+      SPIEL_CHECK_EQ(solved.value, job.Value(counter_air_state));
+      SPIEL_CHECK_EQ(solved.best_action, job.BestAction(counter_air_state));
+      std::vector<Action> actions = state->LegalActions();
+      state->ApplyAction(actions[rng() % actions.size()]);
+    }
+  }
+
+  coordinator.Shutdown();
+  int64_t total_states = 0;
+  for (int rank = 0; rank < kNumWorkers; rank++) {
+    workers[rank].join();
+    // The hash spreads the states over every worker.
+    SPIEL_CHECK_GT(worker_states[rank], 0);
+    total_states += worker_states[rank];
+  }
+  SPIEL_CHECK_EQ(total_states, job.num_states());
+}
+
+void UnixSocketTest() {
+  std::shared_ptr<const Game> game = SmallGame();
+  CounterAirSolveJob job(game, SolveJobOptions());
+  SPIEL_CHECK_TRUE(job.Run());
+
+  char dir[] = "/tmp/counter_air_partitioned_solver_test.XXXXXX";
+  SPIEL_CHECK_TRUE(mkdtemp(dir) != nullptr);
+  constexpr int kNumWorkers = 2;
+  std::vector<pid_t> children;
+  for (int rank = 0; rank < kNumWorkers; rank++) {
+    const pid_t pid = fork();
+    SPIEL_CHECK_GE(pid, 0);
+    if (pid == 0) {
+      {
+        UnixSocketTransport transport(dir, rank, kNumWorkers + 1);
+        RunPartitionWorker(game, &transport, PartitionedSolveOptions());
+      }
+      _exit(0);
+    }
+    children.push_back(pid);
+  }
+  {
+    UnixSocketTransport transport(dir, kNumWorkers, kNumWorkers + 1);
+    PartitionedSolveCoordinator coordinator(game, &transport,
+                                            PartitionedSolveOptions());
+    const SolvedState root = coordinator.Solve();
+    std::unique_ptr<State> state = game->NewInitialState();
+    SPIEL_CHECK_EQ(root.value,
+                   job.Value(static_cast<const CounterAirState&>(*state)));
+    SPIEL_CHECK_EQ(coordinator.progress().num_states, job.num_states());
+    coordinator.Shutdown();
+  }
+  for (pid_t pid : children) {
+    int status;
+    SPIEL_CHECK_EQ(waitpid(pid, &status, 0), pid);
+    SPIEL_CHECK_TRUE(WIFEXITED(status));
+    SPIEL_CHECK_EQ(WEXITSTATUS(status), 0);
+  }
+  SPIEL_CHECK_EQ(rmdir(dir), 0);
+}
+
+}  // namespace
+}  // namespace counter_air
+}  // namespace open_spiel
+
+int main(int argc, char** argv) {
+  open_spiel::counter_air::InProcessTest();
+  open_spiel::counter_air::UnixSocketTest();
+}
@@ -0,0 +1,211 @@
+// Copyright 2019 DeepMind Technologies Limited
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "open_spiel/games/counter_air_policy_store.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <numeric>
+#include <utility>
+#include <vector>
+
+#include "open_spiel/spiel_utils.h"
+
+namespace open_spiel {
+namespace counter_air {
+namespace {
+
+constexpr char kStoreMagic[8] = {'C', 'A', 'P', 'O', 'L', 'Y', '0', '1'};
+static_assert(sizeof(PolicyStoreEntry) == 24, "Store entries are 24 bytes");
+
+struct StoreHeader {
+    char magic[8];
+    uint64_t num_slots;
+    uint64_t num_entries;
+};
+
+// Rounds the probabilities to multiples of 1/kPolicyStoreScale that still sum
+// to one, giving the leftover units to the largest remainders.
+void Quantise(const ActionsAndProbs &policy, PolicyStoreEntry *entry) {
+    std::array<double, kNumDistinctActions> probs{};
+    double total = 0;
+    for (const auto &[action, prob] : policy) {
+        SPIEL_CHECK_GE(action, 0);
+        SPIEL_CHECK_LT(action, kNumDistinctActions);
+        SPIEL_CHECK_GE(prob, 0);
+        probs[action] += prob;
+        total += prob;
+    }
+    SPIEL_CHECK_GT(total, 0);
+    std::array<double, kNumDistinctActions> remainders;
+    int assigned = 0;
+    for (int action = 0; action < kNumDistinctActions; action++) {
+        const double scaled = probs[action] / total * kPolicyStoreScale;
+        entry->weights[action] = static_cast<uint8_t>(std::floor(scaled));
+        remainders[action] = scaled - entry->weights[action];
+        assigned += entry->weights[action];
+    }
+    std::array<int, kNumDistinctActions> order;
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&remainders](int a, int b) {
+        return remainders[a] > remainders[b];
+    });
+    for (int i = 0; assigned < kPolicyStoreScale; i++, assigned++) {
+        entry->weights[order[i]]++;
+    }
+}
+
+ActionsAndProbs Dequantise(const PolicyStoreEntry &entry) {
+    ActionsAndProbs policy;
+    for (Action action = 0; action < kNumDistinctActions; action++) {
+        if (entry.weights[action] == 0) continue;
+        policy.push_back(
+            {action, static_cast<double>(entry.weights[action]) / kPolicyStoreScale});
+    }
+    return policy;
+}
+
+}  // namespace
+
+void PolicyStore::Write(const std::string &path, const CompactPolicyTable &table) {
+    uint64_t num_slots = 1;
+    while (num_slots < 2 * table.size()) num_slots *= 2;
+    std::vector<PolicyStoreEntry> slots(num_slots);
+    for (const auto &[key, policy] : table) {
+        SPIEL_CHECK_NE(key, 0);
+        uint64_t index = key & (num_slots - 1);
+        while (slots[index].key != 0) index = (index + 1) & (num_slots - 1);
+        slots[index].key = key;
+        Quantise(policy, &slots[index]);
+    }
+
+    StoreHeader header;
+    std::memcpy(header.magic, kStoreMagic, sizeof(kStoreMagic));
+    header.num_slots = num_slots;
+    header.num_entries = table.size();
+    // Replace the file rather than truncate it: processes that have the old
+    // store mapped keep its pages instead of faulting on them.
+    const std::string tmp_path = path + ".tmp";
+    std::FILE *file = std::fopen(tmp_path.c_str(), "wb");
+    if (file == nullptr) {
+        SpielFatalError(absl::StrCat("Could not open policy store ", tmp_path));
+    }
+    if (std::fwrite(&header, sizeof(header), 1, file) != 1 ||
+        std::fwrite(slots.data(), num_slots * sizeof(PolicyStoreEntry), 1, file) != 1 ||
+        std::fflush(file) != 0 || fsync(fileno(file)) != 0) {
+        std::fclose(file);
+        SpielFatalError(absl::StrCat("Could not write policy store ", tmp_path));
+    }
+    std::fclose(file);
+    if (std::rename(tmp_path.c_str(), path.c_str()) != 0) {
+        SpielFatalError(absl::StrCat("Could not rename policy store to ", path));
+    }
+}
+
+PolicyStore PolicyStore::Open(const std::string &path) {
+    const int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        SpielFatalError(absl::StrCat("Could not open policy store ", path));
+    }
+    // Validate the header against the file before mapping it: Find() only
+    // terminates if the table has the size it claims and room to spare.
+    struct stat info;
+    StoreHeader header;
+    if (fstat(fd, &info) != 0 || info.st_size < static_cast<off_t>(sizeof(StoreHeader)) ||
+        pread(fd, &header, sizeof(header), 0) != static_cast<ssize_t>(sizeof(header)) ||
+        std::memcmp(header.magic, kStoreMagic, sizeof(kStoreMagic)) != 0) {
+        close(fd);
+        SpielFatalError(absl::StrCat("Not a counter_air policy store: ", path));
+    }
+    const uint64_t num_slots = header.num_slots;
+    const uint64_t data_size = info.st_size - sizeof(StoreHeader);
+    if (num_slots == 0 || (num_slots & (num_slots - 1)) != 0 ||
+        header.num_entries >= num_slots || data_size % sizeof(PolicyStoreEntry) != 0 ||
+        data_size / sizeof(PolicyStoreEntry) != num_slots) {
+        close(fd);
+        SpielFatalError(absl::StrCat("Corrupt or truncated policy store ", path));
+    }
+    PolicyStore store;
+    store.mapping_size_ = info.st_size;
+    store.mapping_ = mmap(nullptr, store.mapping_size_, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (store.mapping_ == MAP_FAILED) {
+        store.mapping_ = nullptr;
+        SpielFatalError(absl::StrCat("Could not map policy store ", path));
+    }
+    // Lookups hit random slots; read-ahead would only pull in unused pages.
+    madvise(store.mapping_, store.mapping_size_, MADV_RANDOM);
+
+    store.slots_ = reinterpret_cast<const PolicyStoreEntry *>(
+        static_cast<const StoreHeader *>(store.mapping_) + 1);
+    store.mask_ = num_slots - 1;
+    store.num_entries_ = header.num_entries;
+    return store;
+}
+
+PolicyStore::PolicyStore(PolicyStore &&other) { *this = std::move(other); }
+
+PolicyStore &PolicyStore::operator=(PolicyStore &&other) {
+    if (this != &other) {
+        if (mapping_ != nullptr) munmap(mapping_, mapping_size_);
+        mapping_ = std::exchange(other.mapping_, nullptr);
+        mapping_size_ = std::exchange(other.mapping_size_, 0);
+        slots_ = std::exchange(other.slots_, nullptr);
+        mask_ = std::exchange(other.mask_, 0);
+        num_entries_ = std::exchange(other.num_entries_, 0);
+    }
+    return *this;
+}
+
+PolicyStore::~PolicyStore() {
+    if (mapping_ != nullptr) munmap(mapping_, mapping_size_);
+}
+
+const PolicyStoreEntry *PolicyStore::Find(uint64_t key) const {
+    if (key == 0) return nullptr;
+    // Bounded by the slot count, in case a damaged file has no empty slot
+    // despite its entry count.
+    uint64_t index = key & mask_;
+    for (uint64_t probes = 0; probes <= mask_; probes++, index = (index + 1) & mask_) {
+        const PolicyStoreEntry &slot = slots_[index];
+        if (slot.key == key) return &slot;
+        if (slot.key == 0) return nullptr;
+    }
+    return nullptr;
+}
+
+ActionsAndProbs PolicyStore::GetStatePolicy(const CounterAirState &state) const {
+    const PolicyStoreEntry *entry = Find(state.StateKey());
+    return entry == nullptr ? ActionsAndProbs() : Dequantise(*entry);
+}
+
+CompactPolicy PolicyStore::AsCompactPolicy(const Game &game) const {
+    CompactPolicy uniform = UniformCompactPolicy(game);
+    return [this, uniform](const CompactState &state) {
+        const PolicyStoreEntry *entry = Find(CompactStateKey(state));
+        if (entry == nullptr) return uniform(state);
+        return Dequantise(*entry);
+    };
+}
+
+}  // namespace counter_air
+}  // namespace open_spiel
@@ -0,0 +1,85 @@
+// Copyright 2019 DeepMind Technologies Limited
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef OPEN_SPIEL_GAMES_COUNTER_AIR_POLICY_STORE_H_
+#define OPEN_SPIEL_GAMES_COUNTER_AIR_POLICY_STORE_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "open_spiel/games/counter_air.h"
+#include "open_spiel/games/counter_air_best_response.h"
+#include "open_spiel/spiel.h"
+
+// Read-only tabular policy file for counter_air, used in place of policies
+// keyed by state strings. The file is an open-addressing hash table of
+// CompactStateKey()s, each mapped to its action probabilities quantised to
+// 1/255, and is opened with mmap: there is nothing to parse, a lookup touches
+// one or two cache lines, and processes opening the same file share its pages.
+//
+// File format: the 8-byte magic "CAPOLY01", a uint64 slot count (a power of
+// two, at least twice the entry count), a uint64 entry count, and then the
+// slots. A slot with key 0 is empty. Keys are used as their own hash; a key is
+// looked up by linear probing from slot key & (slot count - 1).
+
+namespace open_spiel {
+namespace counter_air {
+
+struct PolicyStoreEntry {
+    uint64_t key;
+    // Probability of action i is weights[i] / kPolicyStoreScale.
+    uint8_t weights[kNumDistinctActions];
+    uint8_t padding[3];
+};
+
+inline constexpr int kPolicyStoreScale = 255;
+
+class PolicyStore {
+   public:
+    // Quantises `table` and writes it to `path`.
+    static void Write(const std::string &path, const CompactPolicyTable &table);
+    static PolicyStore Open(const std::string &path);
+
+    PolicyStore(PolicyStore &&other);
+    PolicyStore &operator=(PolicyStore &&other);
+    PolicyStore(const PolicyStore &) = delete;
+    PolicyStore &operator=(const PolicyStore &) = delete;
+    ~PolicyStore();
+
+    // Returns nullptr if the key is not in the store.
+    const PolicyStoreEntry *Find(uint64_t key) const;
+    // Actions with non-zero probability, or an empty policy if the state is
+    // not in the store.
+    ActionsAndProbs GetStatePolicy(const CounterAirState &state) const;
+    // Falls back to the uniform policy for missing states. The store must
+    // outlive the returned policy.
+    CompactPolicy AsCompactPolicy(const Game &game) const;
+
+    int64_t size() const { return num_entries_; }
+
+   private:
+    PolicyStore() = default;
+
+    void *mapping_ = nullptr;
+    size_t mapping_size_ = 0;
+    const PolicyStoreEntry *slots_ = nullptr;
+    uint64_t mask_ = 0;
+    int64_t num_entries_ = 0;
+};
+
+}  // namespace counter_air
+}  // namespace open_spiel
+
+#endif  // OPEN_SPIEL_GAMES_COUNTER_AIR_POLICY_STORE_H_
@@ -0,0 +1,129 @@
+// Copyright 2019 DeepMind Technologies Limited
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "open_spiel/games/counter_air_policy_store.h"
+
+#include <unistd.h>
+
+#include <cstdlib>
+#include <memory>
+#include <random>
+#include <string>
+#include <utility>
+
+#include "open_spiel/games/counter_air.h"
+#include "open_spiel/games/counter_air_best_response.h"
+#include "open_spiel/spiel.h"
+#include "open_spiel/spiel_utils.h"
+
+namespace open_spiel {
+namespace counter_air {
+namespace {
+
+// A random policy over the legal actions of the states of a few random games.
+CompactPolicyTable RandomPolicyTable(const Game& game, int num_games) {
+  CompactPolicyTable table;
+  std::mt19937 rng(0);
+  std::uniform_real_distribution<double> weight(0.0, 1.0);
+  for (int i = 0; i < num_games; i++) {
+    std::unique_ptr<State> state = game.NewInitialState();
+    while (!state->IsTerminal()) {
+      std::vector<Action> actions = state->LegalActions();
+      ActionsAndProbs policy;
+      for (Action action : actions) policy.push_back({action, weight(rng)});
+      table[static_cast<const CounterAirState&>(*state).StateKey()] = policy;
+      state->ApplyAction(actions[rng() % actions.size()]);
+    }
+  }
+  return table;
+}
+
+void RoundTripTest() {
+  std::shared_ptr<const Game> game = LoadGame("counter_air");
+  const CompactPolicyTable table = RandomPolicyTable(*game, 50);
+  char path[] = "/tmp/counter_air_policy_store_test.XXXXXX";
+  const int fd = mkstemp(path);
+  SPIEL_CHECK_GE(fd, 0);
+  close(fd);
+  PolicyStore::Write(path, table);
+  PolicyStore store = PolicyStore::Open(path);
+  SPIEL_CHECK_EQ(store.size(), static_cast<int64_t>(table.size()));
+
+  for (const auto& [key, policy] : table) {
+    const PolicyStoreEntry* entry = store.Find(key);
+    SPIEL_CHECK_TRUE(entry != nullptr);
+    double total = 0;
+    for (const auto& [action, prob] : policy) total += prob;
+    int sum = 0;
+    for (int weight : entry->weights) sum += weight;
+    SPIEL_CHECK_EQ(sum, kPolicyStoreScale);
+    for (const auto& [action, prob] : policy) {
+      SPIEL_CHECK_FLOAT_NEAR(
+          static_cast<double>(entry->weights[action]) / kPolicyStoreScale,
+          prob / total, 1.0 / kPolicyStoreScale);
+    }
+  }
+  SPIEL_CHECK_TRUE(store.Find(12345) == nullptr);
+
+  // States outside the table have no policy in the store and a uniform one
+  // as a CompactPolicy.
+  std::unique_ptr<State> state = game->NewInitialState();
+  state->ApplyAction(state->LegalActions().back());
+  const auto& counter_air = static_cast<const CounterAirState&>(*state);
+  if (table.find(counter_air.StateKey()) == table.end()) {
+    SPIEL_CHECK_TRUE(store.GetStatePolicy(counter_air).empty());
+    SPIEL_CHECK_EQ(store.AsCompactPolicy(*game)(counter_air.ToCompact()).size(),
+                   state->LegalActions().size());
+  }
+
+  // Moving keeps the mapping alive.
+  PolicyStore moved = std::move(store);
+  SPIEL_CHECK_TRUE(moved.Find(table.begin()->first) != nullptr);
+
+  // Rewriting the file leaves an open store reading the old table.
+  PolicyStore::Write(path, CompactPolicyTable());
+  SPIEL_CHECK_EQ(PolicyStore::Open(path).size(), 0);
+  SPIEL_CHECK_EQ(moved.size(), static_cast<int64_t>(table.size()));
+  SPIEL_CHECK_TRUE(moved.Find(table.begin()->first) != nullptr);
+  SPIEL_CHECK_EQ(unlink(path), 0);
+}
+
+void DeterministicPolicyTest() {
+  // A pure policy survives quantisation exactly.
+  std::shared_ptr<const Game> game = LoadGame("counter_air");
+  std::unique_ptr<State> state = game->NewInitialState();
+  const auto& counter_air = static_cast<const CounterAirState&>(*state);
+  CompactPolicyTable table;
+  table[counter_air.StateKey()] = {{3, 1.0}};
+  char path[] = "/tmp/counter_air_policy_store_test.XXXXXX";
+  const int fd = mkstemp(path);
+  SPIEL_CHECK_GE(fd, 0);
+  close(fd);
+  PolicyStore::Write(path, table);
+  PolicyStore store = PolicyStore::Open(path);
+  SPIEL_CHECK_EQ(unlink(path), 0);
+  ActionsAndProbs policy = store.GetStatePolicy(counter_air);
+  SPIEL_CHECK_EQ(policy.size(), 1);
+  SPIEL_CHECK_EQ(policy[0].first, 3);
+  SPIEL_CHECK_EQ(policy[0].second, 1.0);
+}
+
+}  // namespace
+}  // namespace counter_air
+}  // namespace open_spiel
+
+int main(int argc, char** argv) {
+  open_spiel::counter_air::RoundTripTest();
+  open_spiel::counter_air::DeterministicPolicyTest();
+}
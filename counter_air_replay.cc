@@ -0,0 +1,240 @@
+// Copyright 2019 DeepMind Technologies Limited
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "open_spiel/games/counter_air_replay.h"
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+#include "open_spiel/spiel_utils.h"
+
+namespace open_spiel {
+namespace counter_air {
+
+static_assert(sizeof(ReplayEntry) == 52, "Replay entries are 52 bytes");
+
+SumTree::SumTree(int64_t capacity) : leaves_(1) {
+    SPIEL_CHECK_GT(capacity, 0);
+    while (leaves_ < capacity) leaves_ *= 2;
+    nodes_.assign(2 * leaves_, 0.0);
+}
+
+void SumTree::Set(int64_t index, double priority) {
+    SPIEL_CHECK_GE(index, 0);
+    SPIEL_CHECK_LT(index, leaves_);
+    SPIEL_CHECK_GE(priority, 0);
+    int64_t node = leaves_ + index;
+    nodes_[node] = priority;
+    // Recompute the sums rather than add the difference, so that rounding
+    // errors do not build up over many updates.
+    for (node /= 2; node >= 1; node /= 2) nodes_[node] = nodes_[2 * node] + nodes_[2 * node + 1];
+}
+
+int64_t SumTree::Find(double mass) const {
+    int64_t node = 1;
+    while (node < leaves_) {
+        const int64_t left = 2 * node;
+        // An empty right subtree is never chosen, even when rounding leaves
+        // `mass` at or past the left sum.
+        if (mass < nodes_[left] || nodes_[left + 1] <= 0) {
+            node = left;
+        } else {
+            mass -= nodes_[left];
+            node = left + 1;
+        }
+    }
+    return node - leaves_;
+}
+
+PrioritizedReplayBuffer::PrioritizedReplayBuffer(const ReplayOptions &options)
+    : options_(options), tree_(options.capacity), rng_(options.seed) {
+    SPIEL_CHECK_GT(options_.batch_size, 0);
+    SPIEL_CHECK_GT(options_.prefetch, 0);
+}
+
+PrioritizedReplayBuffer::~PrioritizedReplayBuffer() { Stop(); }
+
+int64_t PrioritizedReplayBuffer::Add(const ReplayEntry &entry, double priority) {
+    int64_t index;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (priority < 0) {
+            priority = max_priority_;
+        } else {
+            max_priority_ = std::max(max_priority_, priority);
+        }
+        index = next_;
+        if (index < static_cast<int64_t>(entries_.size())) {
+            entries_[index] = entry;
+        } else {
+            entries_.push_back(entry);
+        }
+        tree_.Set(index, std::pow(priority, options_.alpha));
+        next_ = (next_ + 1) % options_.capacity;
+        size_ = std::min(size_ + 1, options_.capacity);
+    }
+    added_.notify_all();
+    return index;
+}
+
+int64_t PrioritizedReplayBuffer::Add(const CounterAirState &state, Action action,
+                                     float value, double priority) {
+    ReplayEntry entry = {};
+    entry.state = state.ToCompact();
+    for (Action legal : state.LegalActions()) entry.legal_mask |= 1 << legal;
+    entry.action = action;
+    entry.value = value;
+    return Add(entry, priority);
+}
+
+void PrioritizedReplayBuffer::UpdatePriorities(absl::Span<const int64_t> indices,
+                                               absl::Span<const double> priorities) {
+    SPIEL_CHECK_EQ(indices.size(), priorities.size());
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (size_t i = 0; i < indices.size(); i++) {
+        SPIEL_CHECK_LT(indices[i], size_);
+        max_priority_ = std::max(max_priority_, priorities[i]);
+        tree_.Set(indices[i], std::pow(priorities[i], options_.alpha));
+    }
+}
+
+void PrioritizedReplayBuffer::SampleEntries(std::mt19937_64 *rng,
+                                            std::vector<int64_t> *indices,
+                                            std::vector<float> *weights,
+                                            std::vector<ReplayEntry> *entries) {
+    const int n = options_.batch_size;
+    indices->resize(n);
+    weights->resize(n);
+    entries->resize(n);
+    std::uniform_real_distribution<double> uniform(0.0, 1.0);
+    std::lock_guard<std::mutex> lock(mutex_);
+    SPIEL_CHECK_GT(size_, 0);
+    const double total = tree_.total();
+    SPIEL_CHECK_GT(total, 0);
+    // One sample from each of n equal slices of the priority mass.
+    const double segment = total / n;
+    float max_weight = 0;
+    for (int i = 0; i < n; i++) {
+        const int64_t index = tree_.Find(segment * (i + uniform(*rng)));
+        (*indices)[i] = index;
+        (*entries)[i] = entries_[index];
+        const double probability = tree_.Get(index) / total;
+        (*weights)[i] = std::pow(size_ * probability, -options_.beta);
+        max_weight = std::max(max_weight, (*weights)[i]);
+    }
+    for (float &weight : *weights) weight /= max_weight;
+}
+
+void PrioritizedReplayBuffer::Decode(const std::vector<ReplayEntry> &entries,
+                                     ReplayBatch *batch) const {
+    const int n = entries.size();
+    batch->observations.resize(n * kObservationSize);
+    batch->legal_masks.resize(n);
+    batch->actions.resize(n);
+    batch->values.resize(n);
+    for (int i = 0; i < n; i++) {
+        CompactObservationTensor(
+            entries[i].state,
+            absl::MakeSpan(batch->observations).subspan(i * kObservationSize, kObservationSize));
+        batch->legal_masks[i] = entries[i].legal_mask;
+        batch->actions[i] = entries[i].action;
+        batch->values[i] = entries[i].value;
+    }
+}
+
+void PrioritizedReplayBuffer::Sample(ReplayBatch *batch) {
+    std::vector<ReplayEntry> entries;
+    SampleEntries(&rng_, &batch->indices, &batch->weights, &entries);
+    Decode(entries, batch);
+}
+
+void PrioritizedReplayBuffer::Start() {
+    SPIEL_CHECK_TRUE(threads_.empty());
+    stop_ = false;
+    for (int thread = 0; thread < options_.num_decode_threads; thread++) {
+        threads_.emplace_back(&PrioritizedReplayBuffer::DecodeLoop, this, thread);
+    }
+}
+
+void PrioritizedReplayBuffer::Stop() {
+    {
+        std::lock_guard<std::mutex> lock(queue_mutex_);
+        stop_ = true;
+    }
+    // Taking each mutex before notifying ensures that no thread is between
+    // checking stop_ and waiting.
+    { std::lock_guard<std::mutex> lock(mutex_); }
+    added_.notify_all();
+    queue_space_.notify_all();
+    queue_ready_.notify_all();
+    for (std::thread &thread : threads_) thread.join();
+    threads_.clear();
+    queue_.clear();
+    decoding_ = 0;
+}
+
+void PrioritizedReplayBuffer::DecodeLoop(int thread) {
+    std::mt19937_64 rng(options_.seed + thread + 1);
+    std::vector<ReplayEntry> entries;
+    while (true) {
+        {
+            // Reserve a place in the queue before decoding into it.
+            std::unique_lock<std::mutex> lock(queue_mutex_);
+            queue_space_.wait(lock, [&]() {
+                return stop_ || static_cast<int>(queue_.size()) + decoding_ < options_.prefetch;
+            });
+            if (stop_) return;
+            decoding_++;
+        }
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            added_.wait(lock, [&]() { return stop_ || size_ > 0; });
+            if (stop_) return;
+        }
+        ReplayBatch batch;
+        SampleEntries(&rng, &batch.indices, &batch.weights, &entries);
+        Decode(entries, &batch);
+        {
+            std::lock_guard<std::mutex> lock(queue_mutex_);
+            queue_.push_back(std::move(batch));
+            decoding_--;
+        }
+        queue_ready_.notify_one();
+    }
+}
+
+bool PrioritizedReplayBuffer::NextBatch(ReplayBatch *batch) {
+    std::unique_lock<std::mutex> lock(queue_mutex_);
+    queue_ready_.wait(lock, [&]() { return stop_ || !queue_.empty(); });
+    if (queue_.empty()) return false;
+    *batch = std::move(queue_.front());
+    queue_.pop_front();
+    lock.unlock();
+    queue_space_.notify_one();
+    return true;
+}
+
+int64_t PrioritizedReplayBuffer::size() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return size_;
+}
+
+double PrioritizedReplayBuffer::total_priority() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return tree_.total();
+}
+
+}  // namespace counter_air
+}  // namespace open_spiel
@@ -0,0 +1,145 @@
+// Copyright 2019 DeepMind Technologies Limited
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef OPEN_SPIEL_GAMES_COUNTER_AIR_REPLAY_H_
+#define OPEN_SPIEL_GAMES_COUNTER_AIR_REPLAY_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include "absl/types/span.h"
+#include "open_spiel/games/counter_air.h"
+#include "open_spiel/spiel.h"
+
+// Prioritized experience replay for counter_air. Positions are stored as
+// 52-byte ReplayEntry records instead of 246-float observations, about 19
+// times smaller, and sampled in proportion to priority ^ alpha through a sum
+// tree, with importance weights (N * P(i)) ^ -beta normalised by the largest
+// in the batch. Decode threads sample batches ahead of the trainer and
+// write their observations straight into contiguous tensors in the
+// ObservationTensor() layout, so that NextBatch() only hands a batch over.
+
+namespace open_spiel {
+namespace counter_air {
+
+struct ReplayEntry {
+    CompactState state;
+    uint16_t legal_mask;  // Bit a is set if action a is legal.
+    int8_t action;
+    float value;  // Blue's return.
+};
+
+// Binary tree of partial sums over `capacity` non-negative leaves.
+class SumTree {
+   public:
+    explicit SumTree(int64_t capacity);
+
+    void Set(int64_t index, double priority);
+    double Get(int64_t index) const { return nodes_[leaves_ + index]; }
+    double total() const { return nodes_[1]; }
+    // The leaf whose prefix-sum interval holds `mass`, in [0, total()).
+    int64_t Find(double mass) const;
+
+   private:
+    int64_t leaves_;  // A power of two.
+    std::vector<double> nodes_;  // 1-based heap order; leaves from leaves_.
+};
+
+struct ReplayOptions {
+    int64_t capacity = 1 << 20;  // Oldest entries are overwritten beyond it.
+    int batch_size = 256;
+    double alpha = 0.6;
+    double beta = 0.4;
+    int num_decode_threads = 2;
+    int prefetch = 4;  // Decoded batches kept ready.
+    uint64_t seed = 0;
+};
+
+struct ReplayBatch {
+    std::vector<int64_t> indices;  // For UpdatePriorities().
+    std::vector<float> weights;
+    std::vector<float> observations;  // batch_size * kObservationSize.
+    std::vector<uint16_t> legal_masks;
+    std::vector<int8_t> actions;
+    std::vector<float> values;
+};
+
+class PrioritizedReplayBuffer {
+   public:
+    explicit PrioritizedReplayBuffer(const ReplayOptions &options);
+    // Stops the decode threads.
+    ~PrioritizedReplayBuffer();
+    PrioritizedReplayBuffer(const PrioritizedReplayBuffer &) = delete;
+    PrioritizedReplayBuffer &operator=(const PrioritizedReplayBuffer &) = delete;
+
+    // Stores an entry with the given priority, or with the largest priority
+    // seen so far if it is negative, and returns its index.
+    int64_t Add(const ReplayEntry &entry, double priority = -1);
+    int64_t Add(const CounterAirState &state, Action action, float value,
+                double priority = -1);
+    // Typically with the indices of a sampled batch and its new TD errors.
+    // Indices overwritten since they were sampled are updated as well.
+    void UpdatePriorities(absl::Span<const int64_t> indices,
+                          absl::Span<const double> priorities);
+
+    // Samples and decodes a batch on the calling thread; the buffer must not
+    // be empty.
+    void Sample(ReplayBatch *batch);
+
+    // Background sampling. Batches sampled ahead do not see priority updates
+    // made after they were sampled, up to `prefetch` batches.
+    void Start();
+    void Stop();
+    // Blocks until a decoded batch is ready; returns false once stopped.
+    bool NextBatch(ReplayBatch *batch);
+
+    int64_t size() const;
+    double total_priority() const;
+
+   private:
+    void SampleEntries(std::mt19937_64 *rng, std::vector<int64_t> *indices,
+                       std::vector<float> *weights, std::vector<ReplayEntry> *entries);
+    void Decode(const std::vector<ReplayEntry> &entries, ReplayBatch *batch) const;
+    void DecodeLoop(int thread);
+
+    ReplayOptions options_;
+
+    mutable std::mutex mutex_;  // Guards the entries and priorities.
+    std::condition_variable added_;
+    std::vector<ReplayEntry> entries_;
+    SumTree tree_;
+    int64_t size_ = 0;
+    int64_t next_ = 0;
+    double max_priority_ = 1;
+    std::mt19937_64 rng_;  // For Sample().
+
+    std::mutex queue_mutex_;  // Guards the decoded batches; set stop_ under it.
+    std::condition_variable queue_ready_;
+    std::condition_variable queue_space_;
+    std::deque<ReplayBatch> queue_;
+    int decoding_ = 0;  // Batches being decoded, which have a place reserved.
+    std::atomic<bool> stop_{true};
+    std::vector<std::thread> threads_;
+};
+
+}  // namespace counter_air
+}  // namespace open_spiel
+
+#endif  // OPEN_SPIEL_GAMES_COUNTER_AIR_REPLAY_H_
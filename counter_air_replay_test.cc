@@ -0,0 +1,162 @@
+// Copyright 2019 DeepMind Technologies Limited
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "open_spiel/games/counter_air_replay.h"
+
+#include <cmath>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "open_spiel/games/counter_air.h"
+#include "open_spiel/spiel.h"
+#include "open_spiel/spiel_utils.h"
+
+namespace open_spiel {
+namespace counter_air {
+namespace {
+
+void SumTreeTest() {
+  SumTree tree(5);
+  const std::vector<double> priorities = {1, 0, 2, 3, 4};
+  for (int i = 0; i < 5; i++) tree.Set(i, priorities[i]);
+  SPIEL_CHECK_EQ(tree.total(), 10);
+  SPIEL_CHECK_EQ(tree.Find(0), 0);
+  SPIEL_CHECK_EQ(tree.Find(0.999), 0);
+  SPIEL_CHECK_EQ(tree.Find(1), 2);  // Leaf 1 is empty.
+  SPIEL_CHECK_EQ(tree.Find(2.5), 2);
+  SPIEL_CHECK_EQ(tree.Find(3), 3);
+  SPIEL_CHECK_EQ(tree.Find(9.5), 4);
+  // Past the end lands on the last non-empty leaf, not on padding.
+  SPIEL_CHECK_EQ(tree.Find(10), 4);
+  tree.Set(4, 0);
+  SPIEL_CHECK_EQ(tree.total(), 6);
+  SPIEL_CHECK_EQ(tree.Find(6), 3);
+}
+
+void PrioritizedSamplingTest() {
+  ReplayOptions options;
+  options.capacity = 4;
+  options.batch_size = 100;
+  options.alpha = 1;
+  options.beta = 1;
+  PrioritizedReplayBuffer buffer(options);
+  std::vector<int64_t> indices;
+  for (int i = 0; i < 4; i++) {
+    ReplayEntry entry = {};
+    entry.action = i;
+    indices.push_back(buffer.Add(entry, i + 1));
+  }
+  SPIEL_CHECK_EQ(buffer.size(), 4);
+  SPIEL_CHECK_EQ(buffer.total_priority(), 10);
+
+  std::vector<int> counts(4);
+  ReplayBatch batch;
+  for (int round = 0; round < 100; round++) {
+    buffer.Sample(&batch);
+    for (int i = 0; i < options.batch_size; i++) {
+      SPIEL_CHECK_EQ(batch.actions[i], batch.indices[i]);
+      counts[batch.indices[i]]++;
+      // With beta 1 the weights undo the priorities: the least likely entry
+      // has weight 1.
+      const double probability = (batch.indices[i] + 1) / 10.0;
+      SPIEL_CHECK_FLOAT_NEAR(batch.weights[i],
+                             1 / (4 * probability) / (1 / (4 * 0.1)), 1e-5);
+    }
+  }
+  for (int i = 0; i < 4; i++) {
+    SPIEL_CHECK_FLOAT_NEAR(counts[i] / 10000.0, (i + 1) / 10.0, 0.02);
+  }
+
+  // Entries only reach the weight of the least likely one in the batch, so
+  // an update that makes entry 3 unlikely gives it weight 1.
+  buffer.UpdatePriorities({3}, {0.5});
+  SPIEL_CHECK_EQ(buffer.total_priority(), 6.5);
+  buffer.Sample(&batch);
+  for (int i = 0; i < options.batch_size; i++) {
+    if (batch.indices[i] == 3) SPIEL_CHECK_FLOAT_NEAR(batch.weights[i], 1, 1e-6);
+  }
+
+  // New entries get the largest priority so far and replace the oldest.
+  ReplayEntry entry = {};
+  SPIEL_CHECK_EQ(buffer.Add(entry), 0);
+  SPIEL_CHECK_EQ(buffer.size(), 4);
+  SPIEL_CHECK_EQ(buffer.total_priority(), 9.5);
+}
+
+void BackgroundDecodeTest() {
+  std::shared_ptr<const Game> game = LoadGame("counter_air");
+  ReplayOptions options;
+  options.capacity = 1000;
+  options.batch_size = 32;
+  options.num_decode_threads = 3;
+  PrioritizedReplayBuffer buffer(options);
+  buffer.Start();
+
+  // Observations of the states held at each index.
+  std::vector<std::vector<float>> observations(options.capacity);
+  std::vector<uint16_t> legal_masks(options.capacity);
+  std::mt19937 rng(3);
+  int added = 0;
+  while (added < 1500) {
+    std::unique_ptr<State> state = game->NewInitialState();
+    while (!state->IsTerminal()) {
+      const auto& counter_air_state = static_cast<const CounterAirState&>(*state);
+      std::vector<Action> actions = state->LegalActions();
+      const Action action = actions[rng() % actions.size()];
+      const int64_t index =
+          buffer.Add(counter_air_state, action, added % options.capacity % 3 - 1);
+      observations[index] = state->ObservationTensor(0);
+      legal_masks[index] = 0;
+      for (Action legal : actions) legal_masks[index] |= 1 << legal;
+      added++;
+      state->ApplyAction(action);
+    }
+  }
+  SPIEL_CHECK_EQ(buffer.size(), options.capacity);
+
+  // Batches sampled while adding may hold entries overwritten since; restart
+  // to drop them.
+  ReplayBatch batch;
+  SPIEL_CHECK_TRUE(buffer.NextBatch(&batch));
+  buffer.Stop();
+  buffer.Start();
+  for (int round = 0; round < 50; round++) {
+    SPIEL_CHECK_TRUE(buffer.NextBatch(&batch));
+    SPIEL_CHECK_EQ(static_cast<int>(batch.observations.size()),
+                   options.batch_size * kObservationSize);
+    for (int i = 0; i < options.batch_size; i++) {
+      const int64_t index = batch.indices[i];
+      for (int j = 0; j < kObservationSize; j++) {
+        SPIEL_CHECK_EQ(batch.observations[i * kObservationSize + j],
+                       observations[index][j]);
+      }
+      SPIEL_CHECK_EQ(batch.legal_masks[i], legal_masks[index]);
+      SPIEL_CHECK_TRUE(legal_masks[index] & (1 << batch.actions[i]));
+      SPIEL_CHECK_EQ(batch.values[i], index % 3 - 1);
+    }
+  }
+  buffer.Stop();
+  SPIEL_CHECK_FALSE(buffer.NextBatch(&batch));
+}
+
+}  // namespace
+}  // namespace counter_air
+}  // namespace open_spiel
+
+int main(int argc, char** argv) {
+  open_spiel::counter_air::SumTreeTest();
+  open_spiel::counter_air::PrioritizedSamplingTest();
+  open_spiel::counter_air::BackgroundDecodeTest();
+}
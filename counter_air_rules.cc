@@ -0,0 +1,766 @@
+// Copyright 2019 DeepMind Technologies Limited
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "open_spiel/games/counter_air_rules.h"
+
+#include <algorithm>
+#include <initializer_list>
+
+#include "open_spiel/spiel_utils.h"
+
+namespace open_spiel {
+namespace counter_air {
+namespace {
+
+constexpr int kMaxPassLoop = 200;
+
+constexpr uint8_t kPlayer = COUNTER_AIR_FIELD(current_player);
+constexpr uint8_t kWave = COUNTER_AIR_FIELD(current_wave);
+constexpr uint8_t kPhase = COUNTER_AIR_FIELD(current_phase);
+constexpr uint8_t kBlueHits = COUNTER_AIR_FIELD(blue_hits);
+constexpr uint8_t kRedHits = COUNTER_AIR_FIELD(red_hits);
+constexpr uint8_t kBlueFighters = COUNTER_AIR_FIELD(blue_placeable_fighters);
+constexpr uint8_t kRedFighters = COUNTER_AIR_FIELD(red_placeable_fighters);
+constexpr uint8_t kRedSams = COUNTER_AIR_FIELD(red_placeable_sams);
+constexpr uint8_t kAttackingBox = COUNTER_AIR_FIELD(attacking_box);
+constexpr uint8_t kLowStrike = COUNTER_AIR_FIELD(low_strike_attacks);
+constexpr uint8_t kMaxLowStrike = COUNTER_AIR_FIELD(max_low_strike_attacks);
+constexpr uint8_t kActiveSam = COUNTER_AIR_FIELD(active_sam_attacks);
+constexpr uint8_t kMaxActiveSam = COUNTER_AIR_FIELD(max_active_sam_attacks);
+constexpr uint8_t kPassiveSam = COUNTER_AIR_FIELD(passive_sam_attacks);
+constexpr uint8_t kMaxPassiveSam = COUNTER_AIR_FIELD(max_passive_sam_attacks);
+constexpr uint8_t kAirbase = COUNTER_AIR_FIELD(airbase_attacks);
+constexpr uint8_t kMaxAirbase = COUNTER_AIR_FIELD(max_airbase_attacks);
+constexpr uint8_t kAttacking = COUNTER_AIR_FIELD(is_attacking);
+
+// -----------------------------------------------------------------------------
+// Rule construction. Everything here runs at compile time.
+
+constexpr RuleLiteral Positive(int cell) {
+    return {BoardField(cell), RuleCmp::kGt, false, 0};
+}
+constexpr RuleLiteral Empty(int cell) {
+    return {BoardField(cell), RuleCmp::kEq, false, 0};
+}
+constexpr RuleLiteral Equals(uint8_t field, int value) {
+    return {field, RuleCmp::kEq, false, static_cast<int8_t>(value)};
+}
+constexpr RuleLiteral AtLeast(uint8_t field, int value) {
+    return {field, RuleCmp::kGe, false, static_cast<int8_t>(value)};
+}
+constexpr RuleLiteral Below(uint8_t field, uint8_t limit_field) {
+    return {field, RuleCmp::kLt, true, static_cast<int8_t>(limit_field)};
+}
+constexpr RuleLiteral Reached(uint8_t field, uint8_t limit_field) {
+    return {field, RuleCmp::kEq, true, static_cast<int8_t>(limit_field)};
+}
+
+constexpr RuleOp Add(uint8_t field, int delta) {
+    return {RuleOpCode::kAdd, field, static_cast<int8_t>(delta), 0, 0};
+}
+constexpr RuleOp AddAtBox(int offset, int delta) {
+    return {RuleOpCode::kAddAtBox, 0, static_cast<int8_t>(delta),
+            static_cast<uint8_t>(offset), 0};
+}
+constexpr RuleOp Set(uint8_t field, int value) {
+    return {RuleOpCode::kSet, field, static_cast<int8_t>(value), 0, 0};
+}
+constexpr RuleOp Simple(RuleOpCode code, uint8_t field = 0) {
+    return {code, field, 0, 0, 0};
+}
+constexpr RuleOp Transfer(uint8_t field, uint8_t from) {
+    return {RuleOpCode::kTransfer, field, 0, from, 0};
+}
+constexpr RuleOp SetSum(uint8_t field, int cell) {
+    return {RuleOpCode::kSetSum, field, static_cast<int8_t>(cell), 0, 0};
+}
+constexpr RuleOp SetMin(uint8_t field, int cell, int cap) {
+    return {RuleOpCode::kSetMin, field, static_cast<int8_t>(cap),
+            static_cast<uint8_t>(cell), 0};
+}
+constexpr RuleOp SelectBox(int cell) {
+    return {RuleOpCode::kSelectBox, kAttackingBox, 0, static_cast<uint8_t>(cell), 0};
+}
+constexpr RuleOp Damage(uint8_t counter, int hits, int target, uint8_t flags) {
+    return {RuleOpCode::kDamage, counter, static_cast<int8_t>(hits),
+            static_cast<uint8_t>(target), flags};
+}
+constexpr RuleOp Remove(int cell) {
+    return {RuleOpCode::kRemove, 0, 0, static_cast<uint8_t>(cell), 0};
+}
+constexpr RuleOp SkipUnlessBox(int box, int num_ops) {
+    return {RuleOpCode::kSkipUnless, 0, static_cast<int8_t>(num_ops),
+            static_cast<uint8_t>(box), 0};
+}
+
+constexpr void Require(MoveRule *rule, std::initializer_list<RuleLiteral> any_of) {
+    RuleClause &clause = rule->clauses[rule->num_clauses++];
+    for (const RuleLiteral &literal : any_of) {
+        clause.literals[clause.num_literals++] = literal;
+    }
+}
+
+constexpr void Effects(MoveRule *rule, std::initializer_list<RuleOp> ops) {
+    for (const RuleOp &op : ops) {
+        rule->ops[rule->num_ops++] = op;
+    }
+}
+
+// Sets the same rule for every (player, is_attacking) of a phase.
+constexpr void ForAllContexts(RuleTable *table, int phase, Action move,
+                              const MoveRule &rule) {
+    for (int player = 0; player < 2; player++) {
+        table->At(phase, player, false, move) = rule;
+        table->At(phase, player, true, move) = rule;
+    }
+}
+
+constexpr MoveRule Rule(RuleTier tier) {
+    MoveRule rule{};
+    rule.tier = tier;
+    return rule;
+}
+
+constexpr void AddPlacementPhase(RuleTable *table, int phase, uint8_t pool,
+                                 std::initializer_list<RuleOp> effects) {
+    for (Action move = 0; move <= 10; move++) {
+        MoveRule rule = Rule(RuleTier::kPrimary);
+        Require(&rule, {AtLeast(pool, move)});
+        Effects(&rule, effects);
+        ForAllContexts(table, phase, move, rule);
+    }
+}
+
+constexpr void AddFighterCombat(RuleTable *table, const CounterAirConfig &config) {
+    // Blue fires at the intercepting fighters.
+    MoveRule rule = Rule(RuleTier::kPrimary);
+    Require(&rule, {Positive(0)});
+    Require(&rule, {Positive(8)});
+    Effects(&rule, {Set(kAttackingBox, 8), Add(BoardField(0), -1),
+                    Add(BoardField(1), 1), Set(kAttacking, 0), Set(kPlayer, 1),
+                    Simple(RuleOpCode::kCountMove)});
+    table->At(5, 0, true, 1) = rule;
+
+    // Blue defends.
+    rule = Rule(RuleTier::kPrimary);
+    Effects(&rule, {Damage(kBlueHits, 2, 0, kKill | kStrict | kIndirect)});
+    table->At(5, 0, false, 0) = rule;
+    rule = Rule(RuleTier::kPrimary);
+    Require(&rule, {Positive(0)});
+    Effects(&rule, {Add(BoardField(0), -1), Add(BoardField(1), 1),
+                    Damage(kBlueHits, 1, 0, kAnyHalf | kIndirect)});
+    table->At(5, 0, false, 1) = rule;
+    for (int move : {2, 3}) {
+        rule = Rule(RuleTier::kPrimary);
+        Require(&rule, {Equals(kAttackingBox, move == 2 ? 2 : 6)});
+        Effects(&rule, {Damage(kBlueHits, 1, 0, kEvade | kIndirect)});
+        table->At(5, 0, false, move) = rule;
+    }
+
+    // Red fires at the escort, high strike or low strike box.
+    constexpr int kTargets[] = {0, 2, 6};
+    for (int move = 0; move < 3; move++) {
+        rule = Rule(RuleTier::kPrimary);
+        Require(&rule, {Positive(8)});
+        Require(&rule, {Positive(kTargets[move])});
+        Effects(&rule, {Set(kAttackingBox, kTargets[move]), Set(kAttacking, 0),
+                        Add(BoardField(8), -1), Add(BoardField(9), 1),
+                        Set(kPlayer, 0), Simple(RuleOpCode::kCountMove)});
+        table->At(5, 1, true, move) = rule;
+    }
+
+    // Red defends.
+    rule = Rule(RuleTier::kPrimary);
+    Effects(&rule, {Damage(kRedHits, 2, 8, kKill)});
+    table->At(5, 1, false, 0) = rule;
+    rule = Rule(RuleTier::kPrimary);
+    Effects(&rule, {Damage(kRedHits, 1, 8, kEvade)});
+    table->At(5, 1, false, 1) = rule;
+
+    for (int player = 0; player < 2; player++) {
+        for (Action move = 0; move < 4; move++) {
+            MoveRule &defence = table->At(5, player, false, move);
+            if (defence.tier == RuleTier::kIllegal) continue;
+            Effects(&defence, {Set(kAttacking, 1), Simple(RuleOpCode::kCountMove)});
+        }
+    }
+
+    // The phase ends when the interceptors or their targets are gone.
+    rule = Rule(RuleTier::kFallback);
+    Require(&rule, {Empty(8), Empty(0)});
+    Require(&rule, {Empty(8), Empty(2)});
+    Require(&rule, {Empty(8), Empty(6)});
+    Effects(&rule, {SetMin(kMaxLowStrike, 6, config.num_aaa)});
+    ForAllContexts(table, 5, 12, rule);
+}
+
+constexpr void AddGroundToAirCombat(RuleTable *table) {
+    // Blue SEAD attacks the active SAMs or the AAA.
+    for (int move = 0; move < 2; move++) {
+        MoveRule rule = Rule(RuleTier::kPrimary);
+        Require(&rule, {Positive(4)});
+        Require(&rule, {Positive(move == 0 ? 10 : 16)});
+        Effects(&rule, {Set(kAttackingBox, move == 0 ? 10 : 16),
+                        Add(BoardField(4), -1), Add(BoardField(5), 1),
+                        Set(kAttacking, 0), Set(kPlayer, 1),
+                        Simple(RuleOpCode::kCountMove)});
+        table->At(6, 0, true, move) = rule;
+    }
+
+    // Blue defends the high strike or the low strike box.
+    MoveRule rule = Rule(RuleTier::kPrimary);
+    Require(&rule, {Equals(kAttackingBox, 2)});
+    Effects(&rule, {Damage(kBlueHits, 2, 2, kKill)});
+    table->At(6, 0, false, 0) = rule;
+    rule = Rule(RuleTier::kPrimary);
+    Require(&rule, {Equals(kAttackingBox, 2)});
+    Effects(&rule, {Damage(kBlueHits, 1, 2, kEvade)});
+    table->At(6, 0, false, 1) = rule;
+    rule = Rule(RuleTier::kPrimary);
+    Require(&rule, {Equals(kAttackingBox, 2)});
+    Require(&rule, {Positive(4)});
+    Effects(&rule, {Damage(kBlueHits, 1, 2, kKill), Add(BoardField(4), -1),
+                    Add(BoardField(5), 1)});
+    table->At(6, 0, false, 2) = rule;
+    rule = Rule(RuleTier::kPrimary);
+    Require(&rule, {Equals(kAttackingBox, 6)});
+    Effects(&rule, {Damage(kBlueHits, 1, 6, kKill)});
+    table->At(6, 0, false, 3) = rule;
+    for (Action move = 0; move < 4; move++) {
+        Effects(&table->At(6, 0, false, move),
+                {Set(kAttacking, 1), Simple(RuleOpCode::kCountMove)});
+    }
+
+    // Red fires an active SAM at the high strike box, or the AAA at low strike.
+    rule = Rule(RuleTier::kPrimary);
+    Require(&rule, {Positive(10)});
+    Require(&rule, {Positive(2)});
+    Effects(&rule, {Set(kAttackingBox, 2), Set(kAttacking, 0),
+                    Add(BoardField(10), -1), Add(BoardField(11), 1),
+                    Set(kPlayer, 0), Simple(RuleOpCode::kCountMove)});
+    table->At(6, 1, true, 0) = rule;
+    rule = Rule(RuleTier::kPrimary);
+    Require(&rule, {Positive(16)});
+    Require(&rule, {Positive(6)});
+    Require(&rule, {Below(kLowStrike, kMaxLowStrike)});
+    Effects(&rule, {Set(kAttackingBox, 6), Add(kLowStrike, 1),
+                    Add(BoardField(16), -1), Add(BoardField(17), 1),
+                    Set(kPlayer, 0), Simple(RuleOpCode::kCountMove)});
+    table->At(6, 1, true, 1) = rule;
+
+    // Red suffers the SEAD attack.
+    rule = Rule(RuleTier::kPrimary);
+    Effects(&rule, {SkipUnlessBox(10, 1), Damage(kRedHits, 1, 0, kEvade | kIndirect),
+                    SkipUnlessBox(16, 2), AddAtBox(0, -1), AddAtBox(1, 1),
+                    Set(kAttacking, 1), Simple(RuleOpCode::kCountMove)});
+    table->At(6, 1, false, 0) = rule;
+
+    rule = Rule(RuleTier::kPrimary);
+    Require(&rule, {Empty(10), Empty(2)});
+    Require(&rule, {Empty(16), Empty(6), Reached(kLowStrike, kMaxLowStrike)});
+    Require(&rule, {Empty(4), Empty(10)});
+    Require(&rule, {Empty(4), Empty(16)});
+    Effects(&rule, {SetSum(kMaxActiveSam, 10), SetSum(kMaxPassiveSam, 12),
+                    SetSum(kMaxAirbase, 14)});
+    ForAllContexts(table, 6, 12, rule);
+}
+
+// An air-to-ground attack on the airbase, active or passive SAMs. The target
+// cell is chosen before the hit lands.
+constexpr void AddGroundAttack(MoveRule *rule, uint8_t counter, int cell) {
+    Effects(rule, {Add(counter, 1), SelectBox(cell),
+                   Damage(kRedHits, 1, 0, kKill | kIndirect)});
+}
+
+constexpr void AddAirToGroundCombat(RuleTable *table) {
+    // Phase 7: high strike.
+    constexpr uint8_t kCounters[] = {kAirbase, kActiveSam, kPassiveSam};
+    constexpr uint8_t kLimits[] = {kMaxAirbase, kMaxActiveSam, kMaxPassiveSam};
+    constexpr int kCells[] = {14, 10, 12};
+    for (int move = 0; move < 3; move++) {
+        MoveRule rule = Rule(RuleTier::kPrimary);
+        Require(&rule, {Positive(2)});
+        Require(&rule, {Positive(kCells[move]), Positive(kCells[move] + 1)});
+        Require(&rule, {Below(kCounters[move], kLimits[move])});
+        AddGroundAttack(&rule, kCounters[move], kCells[move]);
+        Effects(&rule, {Add(BoardField(2), -1), Add(BoardField(3), 1)});
+        ForAllContexts(table, 7, move, rule);
+    }
+
+    // Phase 8: the UAV, in waves 1 and 3 only.
+    for (int move = 0; move < 2; move++) {
+        MoveRule rule = Rule(RuleTier::kPrimary);
+        Require(&rule, {Equals(kWave, 0), Equals(kWave, 2)});
+        Require(&rule, {Positive(kCells[move + 1]), Positive(kCells[move + 1] + 1)});
+        Require(&rule, {Below(kCounters[move + 1], kLimits[move + 1])});
+        AddGroundAttack(&rule, kCounters[move + 1], kCells[move + 1]);
+        Effects(&rule, {Add(kPhase, 1)});
+        ForAllContexts(table, 8, move, rule);
+    }
+
+    // Phase 9: low strike.
+    MoveRule rule = Rule(RuleTier::kPrimary);
+    Require(&rule, {Positive(6)});
+    Require(&rule, {Positive(14)});
+    Effects(&rule, {Add(BoardField(14), -1), Add(BoardField(15), 1)});
+    ForAllContexts(table, 9, 0, rule);
+    for (int move = 1; move < 3; move++) {
+        rule = Rule(RuleTier::kPrimary);
+        Require(&rule, {Positive(6)});
+        Require(&rule, {Positive(kCells[move]), Positive(kCells[move] + 1)});
+        Require(&rule, {Below(kCounters[move], kLimits[move])});
+        AddGroundAttack(&rule, kCounters[move], kCells[move]);
+        ForAllContexts(table, 9, move, rule);
+    }
+    rule = Rule(RuleTier::kPrimary);
+    Require(&rule, {Positive(6)});
+    Require(&rule, {Positive(8), Positive(9)});
+    Effects(&rule, {Remove(8), Add(BoardField(15), 1)});
+    ForAllContexts(table, 9, 3, rule);
+    for (int player = 0; player < 2; player++) {
+        for (bool attacking : {false, true}) {
+            for (Action move = 0; move < 4; move++) {
+                Effects(&table->At(9, player, attacking, move),
+                        {Add(BoardField(6), -1), Add(BoardField(7), 1)});
+            }
+        }
+    }
+
+    for (int phase = 7; phase <= 9; phase++) {
+        ForAllContexts(table, phase, 12, Rule(RuleTier::kFallback));
+    }
+    rule = Rule(RuleTier::kFallback);
+    Effects(&rule, {Simple(RuleOpCode::kEndWave)});
+    ForAllContexts(table, 9, 12, rule);
+}
+
+// -----------------------------------------------------------------------------
+// Legal-move index, also built at compile time for the default table.
+
+constexpr bool SameLiteral(const RuleLiteral &a, const RuleLiteral &b) {
+    return a.field == b.field && a.cmp == b.cmp && a.rhs_is_field == b.rhs_is_field &&
+           a.rhs == b.rhs;
+}
+
+// Whether two contexts have the same legality rules; their effects may differ.
+constexpr bool SameLegality(const ContextRules &a, const ContextRules &b) {
+    for (int move = 0; move < kNumDistinctActions; move++) {
+        if (a[move].tier != b[move].tier ||
+            a[move].num_clauses != b[move].num_clauses) {
+            return false;
+        }
+        for (int c = 0; c < a[move].num_clauses; c++) {
+            const RuleClause &x = a[move].clauses[c];
+            const RuleClause &y = b[move].clauses[c];
+            if (x.num_literals != y.num_literals) return false;
+            for (int l = 0; l < x.num_literals; l++) {
+                if (!SameLiteral(x.literals[l], y.literals[l])) return false;
+            }
+        }
+    }
+    return true;
+}
+
+constexpr uint16_t ResolveTiers(const uint16_t (&by_tier)[4]) {
+    const int primary = static_cast<int>(RuleTier::kPrimary);
+    if (by_tier[primary]) return by_tier[primary];
+    if (by_tier[primary + 1]) return by_tier[primary + 1];
+    return by_tier[primary + 2];
+}
+
+// A placement context: actions 0..k need AtLeast(pool, action) and nothing
+// else, and every other legal action is unconditional.
+constexpr bool IndexAsRange(const ContextRules &rules, LegalMoveContext *context) {
+    int last = -1;
+    uint16_t by_tier[4] = {0, 0, 0, 0};
+    for (int move = 0; move < kNumDistinctActions; move++) {
+        const MoveRule &rule = rules[move];
+        if (rule.tier == RuleTier::kIllegal) continue;
+        if (rule.num_clauses == 0) {
+            if (rule.tier == RuleTier::kPrimary) return false;
+            by_tier[static_cast<int>(rule.tier)] |= 1 << move;
+            continue;
+        }
+        const RuleClause &clause = rule.clauses[0];
+        if (move != last + 1 || rule.tier != RuleTier::kPrimary ||
+            rule.num_clauses != 1 || clause.num_literals != 1 ||
+            !SameLiteral(clause.literals[0],
+                         {rules[0].clauses[0].literals[0].field, RuleCmp::kGe, false,
+                          static_cast<int8_t>(move)})) {
+            return false;
+        }
+        last = move;
+    }
+    if (last < 0) return false;
+    context->is_range = true;
+    context->range_field = rules[0].clauses[0].literals[0].field;
+    context->range_last = last;
+    context->empty_mask = ResolveTiers(by_tier);
+    return true;
+}
+
+constexpr int LiteralIndex(const LegalMoveContext &context, const RuleLiteral &literal) {
+    for (int i = 0; i < context.num_literals; i++) {
+        if (SameLiteral(context.literals[i], literal)) return i;
+    }
+    return -1;
+}
+
+// Fills the literals of a keyed context and returns false if there are too
+// many.
+constexpr bool CollectLiterals(const ContextRules &rules, LegalMoveContext *context) {
+    for (const MoveRule &rule : rules) {
+        if (rule.tier == RuleTier::kIllegal) continue;
+        for (int c = 0; c < rule.num_clauses; c++) {
+            const RuleClause &clause = rule.clauses[c];
+            for (int l = 0; l < clause.num_literals; l++) {
+                if (LiteralIndex(*context, clause.literals[l]) >= 0) continue;
+                if (context->num_literals == kMaxIndexLiterals) return false;
+                context->literals[context->num_literals++] = clause.literals[l];
+            }
+        }
+    }
+    return true;
+}
+
+constexpr void FillMasks(const ContextRules &rules, const LegalMoveContext &context,
+                         LegalMoveIndex *index) {
+    // Each clause becomes the set of key bits of its literals; it holds when
+    // the key has any of them.
+    uint16_t clause_bits[kNumDistinctActions][kMaxRuleClauses] = {};
+    for (int move = 0; move < kNumDistinctActions; move++) {
+        for (int c = 0; c < rules[move].num_clauses; c++) {
+            const RuleClause &clause = rules[move].clauses[c];
+            for (int l = 0; l < clause.num_literals; l++) {
+                clause_bits[move][c] |= 1 << LiteralIndex(context, clause.literals[l]);
+            }
+        }
+    }
+    for (int key = 0; key < (1 << context.num_literals); key++) {
+        uint16_t by_tier[4] = {0, 0, 0, 0};
+        for (int move = 0; move < kNumDistinctActions; move++) {
+            const MoveRule &rule = rules[move];
+            if (rule.tier == RuleTier::kIllegal) continue;
+            bool holds = true;
+            for (int c = 0; c < rule.num_clauses && holds; c++) {
+                holds = (key & clause_bits[move][c]) != 0;
+            }
+            by_tier[static_cast<int>(rule.tier)] |= holds << move;
+        }
+        index->masks[context.offset + key] = ResolveTiers(by_tier);
+    }
+}
+
+constexpr LegalMoveIndex BuildLegalMoveIndex(const RuleTable &table) {
+    LegalMoveIndex index{};
+    int num_masks = 0;
+    for (int c = 0; c < kNumRuleContexts; c++) {
+        const ContextRules &rules = table.contexts[c];
+        LegalMoveContext &context = index.contexts[c];
+        bool shared = false;
+        for (int earlier = 0; earlier < c && !shared; earlier++) {
+            if (SameLegality(table.contexts[earlier], rules)) {
+                context = index.contexts[earlier];
+                shared = true;
+            }
+        }
+        if (shared || IndexAsRange(rules, &context)) continue;
+        if (!CollectLiterals(rules, &context) ||
+            num_masks + (1 << context.num_literals) > kMaxIndexMasks) {
+            return index;  // Not valid.
+        }
+        context.offset = num_masks;
+        num_masks += 1 << context.num_literals;
+        FillMasks(rules, context, &index);
+    }
+    index.valid = true;
+    return index;
+}
+
+constexpr RuleTable BuildRuleTable(const CounterAirConfig &config) {
+    RuleTable table{};
+    table.num_waves = config.num_waves;
+    table.hit_threshold = config.hit_threshold;
+    AddPlacementPhase(&table, 0, kBlueFighters,
+                      {Simple(RuleOpCode::kSetMove, BoardField(0)),
+                       Simple(RuleOpCode::kSubMove, kBlueFighters), Add(kPhase, 1)});
+    AddPlacementPhase(&table, 1, kBlueFighters,
+                      {Simple(RuleOpCode::kSetMove, BoardField(2)),
+                       Simple(RuleOpCode::kSubMove, kBlueFighters), Add(kPhase, 1)});
+    AddPlacementPhase(&table, 2, kBlueFighters,
+                      {Simple(RuleOpCode::kSetMove, BoardField(4)),
+                       Simple(RuleOpCode::kSubMove, kBlueFighters),
+                       Transfer(BoardField(6), kBlueFighters),
+                       Simple(RuleOpCode::kCountMove),
+                       Simple(RuleOpCode::kFlip, kPlayer), Add(kPhase, 1)});
+    AddPlacementPhase(&table, 3, kRedFighters,
+                      {Simple(RuleOpCode::kSetMove, BoardField(8)),
+                       Simple(RuleOpCode::kSubMove, kRedFighters),
+                       Transfer(BoardField(14), kRedFighters), Add(kPhase, 1)});
+    AddPlacementPhase(&table, 4, kRedSams,
+                      {Simple(RuleOpCode::kSetMove, BoardField(10)),
+                       Simple(RuleOpCode::kSubMove, kRedSams),
+                       Transfer(BoardField(12), kRedSams),
+                       Set(BoardField(16), config.num_aaa),
+                       Simple(RuleOpCode::kFlip, kPlayer), Add(kPhase, 1),
+                       Simple(RuleOpCode::kCountMove)});
+    AddFighterCombat(&table, config);
+    AddGroundToAirCombat(&table);
+    AddAirToGroundCombat(&table);
+
+    for (int phase = 0; phase < kNumPhases; phase++) {
+        // Ending a phase: wave ends already reset the phase.
+        MoveRule end_rule = table.At(phase, 0, true, 12);
+        if (end_rule.tier != RuleTier::kIllegal) {
+            if (phase != 9) Effects(&end_rule, {Add(kPhase, 1)});
+            Effects(&end_rule, {Set(kAttacking, 1), Set(kPlayer, 0)});
+            if (phase == 9) Effects(&end_rule, {Simple(RuleOpCode::kScore)});
+            ForAllContexts(&table, phase, 12, end_rule);
+        }
+        // Passing the turn when nothing else is possible.
+        MoveRule pass = Rule(RuleTier::kLastResort);
+        Effects(&pass, {Simple(RuleOpCode::kFlip, kPlayer),
+                        Simple(RuleOpCode::kCountMove), Set(kAttacking, 1)});
+        ForAllContexts(&table, phase, 11, pass);
+    }
+    table.legal_index = BuildLegalMoveIndex(table);
+    return table;
+}
+
+constexpr RuleTable kDefaultRuleTable = BuildRuleTable(kDefaultConfig);
+static_assert(kDefaultRuleTable.legal_index.valid,
+              "The default rules must fit the legal-move index");
+
+// -----------------------------------------------------------------------------
+// Interpreter.
+
+inline int8_t &Field(CompactState *state, uint8_t offset) {
+    return *reinterpret_cast<int8_t *>(reinterpret_cast<unsigned char *>(state) + offset);
+}
+
+inline int Field(const CompactState &state, uint8_t offset) {
+    return *reinterpret_cast<const int8_t *>(
+        reinterpret_cast<const unsigned char *>(&state) + offset);
+}
+
+inline bool Holds(const CompactState &state, const RuleLiteral &literal) {
+    const int lhs = Field(state, literal.field);
+    const int rhs = literal.rhs_is_field ? Field(state, literal.rhs) : literal.rhs;
+    switch (literal.cmp) {
+        case RuleCmp::kGt:
+            return lhs > rhs;
+        case RuleCmp::kGe:
+            return lhs >= rhs;
+        case RuleCmp::kEq:
+            return lhs == rhs;
+        case RuleCmp::kLt:
+            return lhs < rhs;
+    }
+    return false;
+}
+
+// Holds() without branching on the comparison, for the index keys. Bit
+// (lhs > rhs) + (lhs >= rhs) of the mask is the result of each comparison.
+constexpr uint8_t kCmpTruth[] = {0b100, 0b110, 0b010, 0b001};
+
+inline int HoldsBit(const CompactState &state, const RuleLiteral &literal) {
+    const int lhs = Field(state, literal.field);
+    const int rhs = literal.rhs_is_field ? Field(state, literal.rhs) : literal.rhs;
+    return (kCmpTruth[static_cast<int>(literal.cmp)] >> ((lhs > rhs) + (lhs >= rhs))) & 1;
+}
+
+inline bool Holds(const CompactState &state, const MoveRule &rule) {
+    bool holds = true;
+    for (int c = 0; c < rule.num_clauses; c++) {
+        const RuleClause &clause = rule.clauses[c];
+        bool any = false;
+        for (int l = 0; l < clause.num_literals; l++) {
+            any |= Holds(state, clause.literals[l]);
+        }
+        holds &= any;
+    }
+    return holds;
+}
+
+void ApplyDamage(CompactState *state, const RuleOp &op, int threshold) {
+    int8_t &counter = Field(state, op.field);
+    int8_t &points = op.field == kBlueHits ? state->red_points : state->blue_points;
+    const int target = (op.flags & kIndirect) ? state->attacking_box + op.arg2 : op.arg2;
+    counter += op.arg;
+    const int removed = (op.flags & kStrict) ? counter > threshold
+                                              : counter >= threshold;
+    counter -= threshold * removed;
+    points += removed;
+    switch (op.flags & kModeMask) {
+        case kKill:
+            state->board[target] -= removed;
+            break;
+        case kEvade:
+            state->board[target]--;
+            state->board[target + 1] += 1 - removed;
+            break;
+        case kAnyHalf: {
+            const int attacking = state->board[target] > 0;
+            state->board[target] -= removed & attacking;
+            state->board[target + 1] -= removed & (1 - attacking);
+            break;
+        }
+    }
+}
+
+void EndWave(CompactState *state) {
+    state->current_phase = 0;
+    state->current_wave++;
+    state->low_strike_attacks = 0;
+    state->active_sam_attacks = 0;
+    state->passive_sam_attacks = 0;
+    state->airbase_attacks = 0;
+    auto &board = state->board;
+    state->red_placeable_fighters = board[8] + board[9] + board[14];
+    for (int i = 0; i <= 7; i++) {
+        state->blue_placeable_fighters += board[i];
+    }
+    for (int i = 10; i <= 13; i++) {
+        state->red_placeable_sams += board[i];
+    }
+    const int8_t fighters_in_airbase = board[15];
+    board.fill(0);
+    board[14] = fighters_in_airbase;
+}
+
+void Score(CompactState *state, int num_waves) {
+    if (state->current_wave != num_waves) return;
+    const int margin = state->blue_points - state->red_points;
+    if (margin > 2) {
+        state->outcome = 0;
+    } else if (margin == 2) {
+        state->outcome = state->blue_hits > state->red_hits
+                             ? 0
+                             : (state->blue_hits == state->red_hits ? -1 : 1);
+    } else {
+        state->outcome = 1;
+    }
+}
+
+}  // namespace
+
+const RuleTable &DefaultRuleTable() { return kDefaultRuleTable; }
+
+RuleTable MakeRuleTable(const CounterAirConfig &config) {
+    return BuildRuleTable(config);
+}
+
+void IndexLegalMoves(RuleTable *table) {
+    table->legal_index = BuildLegalMoveIndex(*table);
+}
+
+bool RuleIsTerminal(const RuleTable &table, const CompactState &state) {
+    return state.outcome != kInvalidPlayer || state.current_wave == table.num_waves;
+}
+
+uint16_t RuleLegalMask(const RuleTable &table, const CompactState &state) {
+    if (RuleIsTerminal(table, state)) return 0;
+    const int context_index = RuleTable::ContextIndex(
+        state.current_phase, state.current_player, state.is_attacking);
+    if (table.legal_index.valid) {
+        const LegalMoveContext &context = table.legal_index.contexts[context_index];
+        if (context.is_range) {
+            const int pool = Field(state, context.range_field);
+            if (pool < 0) return context.empty_mask;
+            return (2 << std::min<int>(pool, context.range_last)) - 1;
+        }
+        int key = 0;
+        for (int i = 0; i < context.num_literals; i++) {
+            key |= HoldsBit(state, context.literals[i]) << i;
+        }
+        return table.legal_index.masks[context.offset + key];
+    }
+    const ContextRules &rules = table.contexts[context_index];
+    uint16_t by_tier[4] = {0, 0, 0, 0};
+    for (int move = 0; move < kNumDistinctActions; move++) {
+        const MoveRule &rule = rules[move];
+        by_tier[static_cast<int>(rule.tier)] |= Holds(state, rule) << move;
+    }
+    return ResolveTiers(by_tier);
+}
+
+void RuleApplyAction(const RuleTable &table, CompactState *state, Action move) {
+    const MoveRule &rule = table.At(state->current_phase, state->current_player,
+                                    state->is_attacking, move);
+    for (int i = 0; i < rule.num_ops; i++) {
+        const RuleOp &op = rule.ops[i];
+        switch (op.code) {
+            case RuleOpCode::kAdd:
+                Field(state, op.field) += op.arg;
+                break;
+            case RuleOpCode::kAddAtBox:
+                state->board[state->attacking_box + op.arg2] += op.arg;
+                break;
+            case RuleOpCode::kSet:
+                Field(state, op.field) = op.arg;
+                break;
+            case RuleOpCode::kSetMove:
+                Field(state, op.field) = move;
+                break;
+            case RuleOpCode::kSubMove:
+                Field(state, op.field) -= move;
+                break;
+            case RuleOpCode::kTransfer:
+                Field(state, op.field) = Field(*state, op.arg2);
+                Field(state, op.arg2) = 0;
+                break;
+            case RuleOpCode::kFlip:
+                Field(state, op.field) = 1 - Field(*state, op.field);
+                break;
+            case RuleOpCode::kSetSum:
+                Field(state, op.field) = state->board[op.arg] + state->board[op.arg + 1];
+                break;
+            case RuleOpCode::kSetMin:
+                Field(state, op.field) = std::min<int>(state->board[op.arg2], op.arg);
+                break;
+            case RuleOpCode::kSelectBox:
+                state->attacking_box = op.arg2 + (state->board[op.arg2] == 0);
+                break;
+            case RuleOpCode::kDamage:
+                ApplyDamage(state, op, table.hit_threshold);
+                break;
+            case RuleOpCode::kRemove:
+                if (state->board[op.arg2] > 0) {
+                    state->board[op.arg2]--;
+                } else {
+                    state->board[op.arg2 + 1]--;
+                }
+                break;
+            case RuleOpCode::kSkipUnless:
+                if (state->attacking_box != op.arg2) i += op.arg;
+                break;
+            case RuleOpCode::kCountMove:
+                state->num_moves++;
+                if (move == 11 && state->num_moves > kMaxPassLoop) {
+                    SpielFatalError(absl::StrCat("Invalid player id ",
+                                                 state->current_player));
+                }
+                break;
+            case RuleOpCode::kEndWave:
+                EndWave(state);
+                break;
+            case RuleOpCode::kScore:
+                Score(state, table.num_waves);
+                break;
+        }
+    }
+}
+
+}  // namespace counter_air
+}  // namespace open_spiel
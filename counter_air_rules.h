@@ -0,0 +1,191 @@
+// Copyright 2019 DeepMind Technologies Limited
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef OPEN_SPIEL_GAMES_COUNTER_AIR_RULES_H_
+#define OPEN_SPIEL_GAMES_COUNTER_AIR_RULES_H_
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include "open_spiel/games/counter_air.h"
+#include "open_spiel/spiel.h"
+
+// Table-driven rule engine working on CompactState. The rules of every
+// context (phase, player, is_attacking) are data: for each of the 13 actions a
+// legality predicate in conjunctive normal form and a short list of effect
+// ops. A small interpreter evaluates them. Tables reproduce
+// CounterAirState::LegalActions() and DoApplyAction() exactly; variants are
+// made by editing a copy of one.
+
+namespace open_spiel {
+namespace counter_air {
+
+inline constexpr int kNumPhases = 10;
+inline constexpr int kNumRuleContexts = kNumPhases * 2 * 2;
+
+// Offset of a CompactState field, as used by predicates and ops.
+#define COUNTER_AIR_FIELD(name) \
+    static_cast<uint8_t>(offsetof(::open_spiel::counter_air::CompactState, name))
+
+constexpr uint8_t BoardField(int cell) {
+    return COUNTER_AIR_FIELD(board) + cell;
+}
+
+enum class RuleCmp : uint8_t { kGt, kGe, kEq, kLt };
+
+// Compares a field with a constant or, if rhs_is_field, with another field.
+struct RuleLiteral {
+    uint8_t field;
+    RuleCmp cmp;
+    bool rhs_is_field;
+    int8_t rhs;
+};
+
+inline constexpr int kMaxRuleLiterals = 3;
+inline constexpr int kMaxRuleClauses = 4;
+inline constexpr int kMaxRuleOps = 8;
+
+// Disjunction of literals.
+struct RuleClause {
+    std::array<RuleLiteral, kMaxRuleLiterals> literals;
+    uint8_t num_literals;
+};
+
+enum class RuleOpCode : uint8_t {
+    kAdd,         // field += arg
+    kAddAtBox,    // board[attacking_box + arg2] += arg
+    kSet,         // field = arg
+    kSetMove,     // field = move
+    kSubMove,     // field -= move
+    kTransfer,    // field = arg2 field; arg2 field = 0
+    kFlip,        // field = 1 - field
+    kSetSum,      // field = board[arg] + board[arg + 1]
+    kSetMin,      // field = min(board[arg2], arg)
+    kSelectBox,   // attacking_box = arg2, or arg2 + 1 when that cell is empty
+    kDamage,      // See RuleDamage.
+    kRemove,      // Removes a counter from box arg2, attacking side first.
+    kSkipUnless,  // Skips the next arg ops unless attacking_box == arg2.
+    kCountMove,   // num_moves++, guarding against pass loops.
+    kEndWave,     // Recovers the surviving forces and clears the board.
+    kScore,       // Decides the outcome after the final wave.
+};
+
+// Flags of kDamage: `field` is the hit counter, `arg` the hits dealt and
+// `arg2` the target cell, or its offset from attacking_box with kIndirect.
+// Reaching the hit threshold removes a target and scores a point.
+enum RuleDamage : uint8_t {
+    kKill = 0,      // Only a removed target leaves its cell.
+    kEvade = 1,     // The target evades unless it is removed.
+    kAnyHalf = 2,   // Removes from the evading side if no target attacks.
+    kModeMask = 3,
+    kStrict = 4,    // Needs more than the threshold, not at least it.
+    kIndirect = 8,
+};
+
+struct RuleOp {
+    RuleOpCode code;
+    uint8_t field;
+    int8_t arg;
+    uint8_t arg2;
+    uint8_t flags;
+};
+
+enum class RuleTier : uint8_t {
+    kIllegal,
+    kPrimary,     // Legal whenever the predicate holds.
+    kFallback,    // Only when no primary action is legal.
+    kLastResort,  // Only when nothing else is legal.
+};
+
+struct MoveRule {
+    RuleTier tier;
+    uint8_t num_clauses;
+    uint8_t num_ops;
+    std::array<RuleClause, kMaxRuleClauses> clauses;
+    std::array<RuleOp, kMaxRuleOps> ops;
+};
+
+using ContextRules = std::array<MoveRule, kNumDistinctActions>;
+
+// Legal-move index of a RuleTable, generated from its predicates. Within a
+// context, legality depends only on the distinct literals of its rules, so
+// the truth values of those literals form a key that selects a precomputed
+// mask. Placement contexts, where action a needs pool >= a, are stored as a
+// range instead. Contexts with the same legality rules share their masks.
+inline constexpr int kMaxIndexLiterals = 12;
+inline constexpr int kMaxIndexMasks = 1 << 13;
+
+struct LegalMoveContext {
+    bool is_range;
+    // Ranges: actions 0..min(range_field, range_last) are legal, or
+    // empty_mask when the field is negative.
+    uint8_t range_field;
+    int8_t range_last;
+    uint16_t empty_mask;
+    // Keys: bit i is literals[i]; the mask is masks[offset + key].
+    uint8_t num_literals;
+    uint16_t offset;
+    std::array<RuleLiteral, kMaxIndexLiterals> literals;
+};
+
+struct LegalMoveIndex {
+    // False when the table was edited after indexing, or when its contexts
+    // need more than kMaxIndexLiterals literals or kMaxIndexMasks masks.
+    bool valid;
+    std::array<LegalMoveContext, kNumRuleContexts> contexts;
+    std::array<uint16_t, kMaxIndexMasks> masks;
+};
+
+struct RuleTable {
+    std::array<ContextRules, kNumRuleContexts> contexts;
+    int8_t num_waves;
+    int8_t hit_threshold;
+    // Used by RuleLegalMask when valid. Editing rules through At() marks it
+    // stale; IndexLegalMoves() rebuilds it.
+    LegalMoveIndex legal_index;
+
+    static constexpr int ContextIndex(int phase, int player, bool attacking) {
+        return (phase * 2 + player) * 2 + attacking;
+    }
+    constexpr const ContextRules &Context(int phase, int player,
+                                          bool attacking) const {
+        return contexts[ContextIndex(phase, player, attacking)];
+    }
+    constexpr MoveRule &At(int phase, int player, bool attacking, Action move) {
+        legal_index.valid = false;
+        return contexts[ContextIndex(phase, player, attacking)][move];
+    }
+    constexpr const MoveRule &At(int phase, int player, bool attacking,
+                                 Action move) const {
+        return Context(phase, player, attacking)[move];
+    }
+};
+
+// The rules of the standard game, generated at compile time.
+const RuleTable &DefaultRuleTable();
+// The rules of a game with the given parameters.
+RuleTable MakeRuleTable(const CounterAirConfig &config);
+// Rebuilds the legal-move index after the rules were edited.
+void IndexLegalMoves(RuleTable *table);
+
+bool RuleIsTerminal(const RuleTable &table, const CompactState &state);
+// Bit i is set when action i is legal.
+uint16_t RuleLegalMask(const RuleTable &table, const CompactState &state);
+void RuleApplyAction(const RuleTable &table, CompactState *state, Action move);
+
+}  // namespace counter_air
+}  // namespace open_spiel
+
+#endif  // OPEN_SPIEL_GAMES_COUNTER_AIR_RULES_H_
@@ -0,0 +1,136 @@
+// Copyright 2019 DeepMind Technologies Limited
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "open_spiel/games/counter_air_rules.h"
+
+#include <cstring>
+#include <random>
+#include <vector>
+
+#include "open_spiel/spiel.h"
+#include "open_spiel/spiel_utils.h"
+
+namespace open_spiel {
+namespace counter_air {
+namespace {
+
+uint16_t ToMask(const std::vector<Action>& actions) {
+  uint16_t mask = 0;
+  for (Action action : actions) mask |= 1 << action;
+  return mask;
+}
+
+// The table engine must follow the reference implementation move by move.
+void MatchesReference(const GameParameters& params, const RuleTable& table) {
+  std::shared_ptr<const Game> game = LoadGame("counter_air", params);
+  std::mt19937 rng(0);
+  for (int i = 0; i < 2000; ++i) {
+    std::unique_ptr<State> state = game->NewInitialState();
+    const auto& reference = static_cast<const CounterAirState&>(*state);
+    CompactState compact = reference.ToCompact();
+    while (!state->IsTerminal()) {
+      std::vector<Action> legal = state->LegalActions();
+      SPIEL_CHECK_EQ(RuleLegalMask(table, compact), ToMask(legal));
+      std::uniform_int_distribution<int> dist(0, legal.size() - 1);
+      Action action = legal[dist(rng)];
+      state->ApplyAction(action);
+      RuleApplyAction(table, &compact, action);
+      CompactState expected = reference.ToCompact();
+      SPIEL_CHECK_EQ(std::memcmp(&compact, &expected, sizeof(CompactState)), 0);
+    }
+    SPIEL_CHECK_TRUE(RuleIsTerminal(table, compact));
+    SPIEL_CHECK_EQ(RuleLegalMask(table, compact), 0);
+  }
+}
+
+void MatchesReferenceTest() {
+  MatchesReference({}, DefaultRuleTable());
+  CounterAirConfig config;
+  config.blue_fighters = 6;
+  config.num_waves = 2;
+  config.num_aaa = 2;
+  config.hit_threshold = 3;
+  MatchesReference({{"blue_fighters", GameParameter(6)},
+                    {"num_waves", GameParameter(2)},
+                    {"num_aaa", GameParameter(2)},
+                    {"hit_threshold", GameParameter(3)}},
+                   MakeRuleTable(config));
+}
+
+// Variants are made by editing a copy of the default table.
+void VariantTest() {
+  RuleTable variant = DefaultRuleTable();
+  for (Action move = 4; move <= 10; ++move) {
+    for (int player = 0; player < 2; ++player) {
+      variant.At(0, player, true, move).tier = RuleTier::kIllegal;
+    }
+  }
+  std::shared_ptr<const Game> game = LoadGame("counter_air");
+  std::unique_ptr<State> state = game->NewInitialState();
+  CompactState compact =
+      static_cast<const CounterAirState&>(*state).ToCompact();
+  SPIEL_CHECK_FALSE(variant.legal_index.valid);
+  SPIEL_CHECK_EQ(RuleLegalMask(variant, compact), 0b1111);
+  IndexLegalMoves(&variant);
+  SPIEL_CHECK_TRUE(variant.legal_index.valid);
+  SPIEL_CHECK_EQ(RuleLegalMask(variant, compact), 0b1111);
+  SPIEL_CHECK_EQ(RuleLegalMask(DefaultRuleTable(), compact), 0b11111111111);
+}
+
+// The legal-move index must agree with the interpreter on every context,
+// including states no game reaches.
+void CheckIndex(const RuleTable& table) {
+  SPIEL_CHECK_TRUE(table.legal_index.valid);
+  RuleTable interpreted = table;
+  interpreted.legal_index.valid = false;
+  std::mt19937 rng(0);
+  std::uniform_int_distribution<int> small(-1, 4);
+  for (int i = 0; i < 200000; ++i) {
+    CompactState state;
+    auto* bytes = reinterpret_cast<int8_t*>(&state);
+    for (size_t b = 0; b < sizeof(CompactState); ++b) bytes[b] = small(rng);
+    state.current_phase = rng() % kNumPhases;
+    state.current_player = rng() % 2;
+    state.is_attacking = rng() % 2;
+    state.current_wave = rng() % table.num_waves;
+    state.outcome = kInvalidPlayer;
+    state.is_uav = rng() % 2;
+    state.attacking_box = std::uniform_int_distribution<int>(0, 17)(rng);
+    // Placement pools beyond the largest placement.
+    state.blue_placeable_fighters =
+        std::uniform_int_distribution<int>(-1, 12)(rng);
+    SPIEL_CHECK_EQ(RuleLegalMask(table, state),
+                   RuleLegalMask(interpreted, state));
+  }
+}
+
+void LegalMoveIndexTest() {
+  CheckIndex(DefaultRuleTable());
+  CounterAirConfig config;
+  config.blue_fighters = 6;
+  config.num_waves = 2;
+  config.num_aaa = 2;
+  config.hit_threshold = 3;
+  CheckIndex(MakeRuleTable(config));
+}
+
+}  // namespace
+}  // namespace counter_air
+}  // namespace open_spiel
+
+int main(int argc, char** argv) {
+  open_spiel::counter_air::MatchesReferenceTest();
+  open_spiel::counter_air::VariantTest();
+  open_spiel::counter_air::LegalMoveIndexTest();
+}
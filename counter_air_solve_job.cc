@@ -0,0 +1,263 @@
+// Copyright 2019 DeepMind Technologies Limited
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "open_spiel/games/counter_air_solve_job.h"
+
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cstdio>
+#include <cstring>
+#include <utility>
+
+#include "absl/strings/str_cat.h"
+#include "absl/time/clock.h"
+#include "open_spiel/games/counter_air_rules.h"
+#include "open_spiel/spiel_utils.h"
+
+namespace open_spiel {
+namespace counter_air {
+namespace {
+
+constexpr char kJobMagic[8] = {'C', 'A', 'J', 'O', 'B', '0', '0', '2'};
+// Nodes between looks at the clock.
+constexpr int64_t kClockInterval = 4096;
+
+struct CheckpointHeader {
+    char magic[8];
+    CounterAirConfig config;
+    int64_t nodes;
+    int64_t num_solved;
+    int64_t stack_depth;
+    int32_t root_solved;
+};
+
+struct CheckpointEntry {
+    uint64_t key;
+    SolvedState solved;
+};
+
+int8_t TerminalValue(const CompactState &state) {
+    if (state.outcome == 0) return 1;
+    if (state.outcome == 1) return -1;
+    return 0;
+}
+
+void WriteOrDie(std::FILE *file, const void *data, size_t size,
+                const std::string &path) {
+    if (size > 0 && std::fwrite(data, size, 1, file) != 1) {
+        std::fclose(file);
+        SpielFatalError(absl::StrCat("Could not write checkpoint ", path));
+    }
+}
+
+bool ReadAll(std::FILE *file, void *data, size_t size) {
+    return size == 0 || std::fread(data, size, 1, file) == 1;
+}
+
+}  // namespace
+
+CounterAirSolveJob::CounterAirSolveJob(std::shared_ptr<const Game> game,
+                                       SolveJobOptions options)
+    : game_(game),
+      rules_(static_cast<const CounterAirGame &>(*game).rules()),
+      options_(std::move(options)) {
+    resumed_ = !options_.checkpoint_path.empty() && LoadCheckpoint();
+    if (!resumed_) {
+        std::unique_ptr<State> root = game_->NewInitialState();
+        PushFrame(static_cast<const CounterAirState &>(*root).ToCompact());
+    }
+}
+
+void CounterAirSolveJob::PushFrame(const CompactState &state) {
+    const bool maximising = state.current_player == 0;
+    stack_.push_back({state, 0, static_cast<int8_t>(maximising ? -2 : 2),
+                      static_cast<int8_t>(kInvalidAction)});
+}
+
+bool CounterAirSolveJob::Run() {
+    run_start_ = absl::Now();
+    run_start_nodes_ = nodes_;
+    absl::Time next_checkpoint = run_start_ + options_.checkpoint_interval;
+    absl::Time next_progress = run_start_ + options_.progress_interval;
+    const bool checkpoints = !options_.checkpoint_path.empty();
+
+    while (!stack_.empty()) {
+        Frame &top = stack_.back();
+        const uint16_t legal = RuleLegalMask(rules_, top.state);
+        int action = top.next_action;
+        while (action < kNumDistinctActions && !(legal & (1 << action))) action++;
+
+        int value;
+        if (action < kNumDistinctActions) {
+            top.next_action = action + 1;
+            CompactState child = top.state;
+            RuleApplyAction(rules_, &child, action);
+            nodes_++;
+            if (RuleIsTerminal(rules_, child)) {
+                value = TerminalValue(child);
+            } else {
+                auto it = table_.find(CanonicalStateKey(child));
+                if (it == table_.end()) {
+                    PushFrame(child);
+                    continue;
+                }
+                value = it->second.value;
+            }
+        } else {
+            // Every child is done: the state is solved.
+            value = top.best_value;
+            table_[CanonicalStateKey(top.state)] = {top.best_value, top.best_action};
+            stack_.pop_back();
+            if (stack_.empty()) {
+                root_solved_ = true;
+                break;
+            }
+            action = stack_.back().next_action - 1;
+        }
+
+        Frame &parent = stack_.back();
+        const bool maximising = parent.state.current_player == 0;
+        if (maximising ? value > parent.best_value : value < parent.best_value) {
+            parent.best_value = value;
+            parent.best_action = action;
+        }
+
+        if (nodes_ % kClockInterval == 0) {
+            const absl::Time now = absl::Now();
+            if (options_.progress && now >= next_progress) {
+                options_.progress(Progress());
+                next_progress = now + options_.progress_interval;
+            }
+            if (checkpoints && now >= next_checkpoint) {
+                Checkpoint();
+                next_checkpoint = now + options_.checkpoint_interval;
+            }
+        }
+        if (options_.max_nodes >= 0 && nodes_ - run_start_nodes_ >= options_.max_nodes) {
+            break;
+        }
+    }
+
+    if (checkpoints) Checkpoint();
+    if (options_.progress) options_.progress(Progress());
+    return finished();
+}
+
+SolveJobProgress CounterAirSolveJob::Progress() const {
+    SolveJobProgress progress;
+    progress.solved_states = table_.size();
+    progress.nodes = nodes_;
+    progress.stack_depth = stack_.size();
+    progress.elapsed = absl::Now() - run_start_;
+    const double seconds = absl::ToDoubleSeconds(progress.elapsed);
+    if (seconds > 0) progress.nodes_per_second = (nodes_ - run_start_nodes_) / seconds;
+    progress.resumed = resumed_;
+    return progress;
+}
+
+void CounterAirSolveJob::Checkpoint() const {
+    const std::string &path = options_.checkpoint_path;
+    SPIEL_CHECK_FALSE(path.empty());
+    const std::string tmp_path = path + ".tmp";
+    std::FILE *file = std::fopen(tmp_path.c_str(), "wb");
+    if (file == nullptr) {
+        SpielFatalError(absl::StrCat("Could not open checkpoint ", tmp_path));
+    }
+    CheckpointHeader header = {};
+    std::memcpy(header.magic, kJobMagic, sizeof(kJobMagic));
+    header.config = static_cast<const CounterAirGame &>(*game_).config();
+    header.nodes = nodes_;
+    header.num_solved = table_.size();
+    header.stack_depth = stack_.size();
+    header.root_solved = root_solved_;
+    WriteOrDie(file, &header, sizeof(header), tmp_path);
+    std::vector<CheckpointEntry> entries;
+    entries.reserve(table_.size());
+    for (const auto &[key, solved] : table_) entries.push_back({key, solved});
+    WriteOrDie(file, entries.data(), entries.size() * sizeof(CheckpointEntry), tmp_path);
+    WriteOrDie(file, stack_.data(), stack_.size() * sizeof(Frame), tmp_path);
+    if (std::fflush(file) != 0 || fsync(fileno(file)) != 0) {
+        std::fclose(file);
+        SpielFatalError(absl::StrCat("Could not sync checkpoint ", tmp_path));
+    }
+    std::fclose(file);
+    if (std::rename(tmp_path.c_str(), path.c_str()) != 0) {
+        SpielFatalError(absl::StrCat("Could not rename checkpoint to ", path));
+    }
+}
+
+bool CounterAirSolveJob::LoadCheckpoint() {
+    const std::string &path = options_.checkpoint_path;
+    std::FILE *file = std::fopen(path.c_str(), "rb");
+    if (file == nullptr) return false;
+    CheckpointHeader header;
+    if (!ReadAll(file, &header, sizeof(header)) ||
+        std::memcmp(header.magic, kJobMagic, sizeof(kJobMagic)) != 0) {
+        std::fclose(file);
+        SpielFatalError(absl::StrCat("Not a counter_air solve checkpoint: ", path));
+    }
+    if (!(header.config == static_cast<const CounterAirGame &>(*game_).config())) {
+        std::fclose(file);
+        SpielFatalError(absl::StrCat("Checkpoint ", path, " is for another game config"));
+    }
+    // The counts size the allocations below, so check them against the file.
+    struct stat info;
+    const int64_t entry_size = sizeof(CheckpointEntry);
+    const int64_t frame_size = sizeof(Frame);
+    if (fstat(fileno(file), &info) != 0 || header.num_solved < 0 || header.stack_depth < 0 ||
+        header.num_solved > info.st_size / entry_size ||
+        header.stack_depth > info.st_size / frame_size ||
+        static_cast<int64_t>(sizeof(header)) + header.num_solved * entry_size +
+                header.stack_depth * frame_size !=
+            info.st_size) {
+        std::fclose(file);
+        SpielFatalError(absl::StrCat("Corrupt checkpoint ", path,
+                                     ": its counts do not match its size"));
+    }
+    std::vector<CheckpointEntry> entries(header.num_solved);
+    stack_.resize(header.stack_depth);
+    const bool complete =
+        ReadAll(file, entries.data(), entries.size() * sizeof(CheckpointEntry)) &&
+        ReadAll(file, stack_.data(), stack_.size() * sizeof(Frame));
+    std::fclose(file);
+    if (!complete) {
+        SpielFatalError(absl::StrCat("Truncated checkpoint ", path));
+    }
+    table_.reserve(entries.size());
+    for (const CheckpointEntry &entry : entries) table_[entry.key] = entry.solved;
+    nodes_ = header.nodes;
+    root_solved_ = header.root_solved;
+    return true;
+}
+
+const SolvedState &CounterAirSolveJob::Lookup(const CounterAirState &state) const {
+    auto it = table_.find(state.CanonicalKey());
+    if (it == table_.end()) {
+        SpielFatalError("State not solved");
+    }
+    return it->second;
+}
+
+int CounterAirSolveJob::Value(const CounterAirState &state) const {
+    if (state.IsTerminal()) return TerminalValue(state.ToCompact());
+    return Lookup(state).value;
+}
+
+Action CounterAirSolveJob::BestAction(const CounterAirState &state) const {
+    return Lookup(state).best_action;
+}
+
+}  // namespace counter_air
+}  // namespace open_spiel
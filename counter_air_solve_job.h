@@ -0,0 +1,116 @@
+// Copyright 2019 DeepMind Technologies Limited
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef OPEN_SPIEL_GAMES_COUNTER_AIR_SOLVE_JOB_H_
+#define OPEN_SPIEL_GAMES_COUNTER_AIR_SOLVE_JOB_H_
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "absl/container/flat_hash_map.h"
+#include "absl/time/time.h"
+#include "open_spiel/games/counter_air.h"
+#include "open_spiel/spiel.h"
+
+// Long-running exact solve of counter_air that survives preemption. The job
+// enumerates every state reachable from the initial state and computes its
+// minimax value (Blue maximising, Red minimising Blue's return) and best
+// action. States are keyed by CanonicalStateKey(), so each transposition is
+// solved once. The depth-first search keeps its stack explicitly, so the stack and
+// the table of solved states together are the whole job state; both are
+// written to a checkpoint periodically and the job resumes from it.
+//
+// Checkpoints are written to "<path>.tmp", synced and renamed over <path>, so
+// the file on disk is always a complete checkpoint. Format: the 8-byte magic
+// "CAJOB002", the game config, the counters, the solved table and the stack.
+
+namespace open_spiel {
+namespace counter_air {
+
+struct SolvedState {
+    int8_t value;  // Blue's return.
+    int8_t best_action;
+};
+
+struct SolveJobProgress {
+    int64_t solved_states = 0;
+    int64_t nodes = 0;  // Children generated, over all runs of the job.
+    int stack_depth = 0;
+    double nodes_per_second = 0;  // Since this run started.
+    absl::Duration elapsed;       // Of this run.
+    bool resumed = false;
+};
+
+struct SolveJobOptions {
+    // Empty disables checkpoints.
+    std::string checkpoint_path;
+    absl::Duration checkpoint_interval = absl::Minutes(10);
+    absl::Duration progress_interval = absl::Seconds(30);
+    // Called every progress_interval and when the run ends.
+    std::function<void(const SolveJobProgress &)> progress;
+    // Stops the run, after writing a checkpoint, once this many nodes have
+    // been generated in it; -1 runs to completion.
+    int64_t max_nodes = -1;
+};
+
+class CounterAirSolveJob {
+   public:
+    // Resumes from options.checkpoint_path if it holds a checkpoint.
+    CounterAirSolveJob(std::shared_ptr<const Game> game, SolveJobOptions options);
+
+    // Returns true once every reachable state is solved.
+    bool Run();
+    bool finished() const { return stack_.empty() && root_solved_; }
+
+    // Writes the current job state to options.checkpoint_path.
+    void Checkpoint() const;
+
+    // The state must be solved.
+    int Value(const CounterAirState &state) const;
+    Action BestAction(const CounterAirState &state) const;
+
+    int64_t num_states() const { return table_.size(); }
+    SolveJobProgress Progress() const;
+
+   private:
+    struct Frame {
+        CompactState state;
+        int8_t next_action;
+        int8_t best_value;
+        int8_t best_action;
+    };
+
+    bool LoadCheckpoint();
+    void PushFrame(const CompactState &state);
+    const SolvedState &Lookup(const CounterAirState &state) const;
+
+    std::shared_ptr<const Game> game_;
+    const RuleTable &rules_;
+    SolveJobOptions options_;
+    absl::flat_hash_map<uint64_t, SolvedState> table_;
+    std::vector<Frame> stack_;
+    bool root_solved_ = false;
+    bool resumed_ = false;
+    int64_t nodes_ = 0;
+    int64_t run_start_nodes_ = 0;
+    absl::Time run_start_;
+};
+
+}  // namespace counter_air
+}  // namespace open_spiel
+
+#endif  // OPEN_SPIEL_GAMES_COUNTER_AIR_SOLVE_JOB_H_
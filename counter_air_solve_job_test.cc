@@ -0,0 +1,120 @@
+// Copyright 2019 DeepMind Technologies Limited
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "open_spiel/games/counter_air_solve_job.h"
+
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "open_spiel/games/counter_air.h"
+#include "open_spiel/spiel.h"
+#include "open_spiel/spiel_utils.h"
+
+namespace open_spiel {
+namespace counter_air {
+namespace {
+
+std::shared_ptr<const Game> SmallGame(int blue_fighters, int red_fighters,
+                                      int hit_threshold) {
+  return LoadGame("counter_air",
+                  {{"blue_fighters", GameParameter(blue_fighters)},
+                   {"red_fighters", GameParameter(red_fighters)},
+                   {"red_sams", GameParameter(1)},
+                   {"num_waves", GameParameter(1)},
+                   {"num_aaa", GameParameter(1)},
+                   {"hit_threshold", GameParameter(hit_threshold)}});
+}
+
+// Plain minimax over State objects, without memoisation.
+double ReferenceValue(const State& state) {
+  if (state.IsTerminal()) return state.Returns()[0];
+  std::vector<double> values;
+  for (Action action : state.LegalActions()) {
+    values.push_back(ReferenceValue(*state.Child(action)));
+  }
+  return state.CurrentPlayer() == 0
+             ? *std::max_element(values.begin(), values.end())
+             : *std::min_element(values.begin(), values.end());
+}
+
+void MatchesReferenceTest() {
+  std::shared_ptr<const Game> game = SmallGame(1, 1, 1);
+  CounterAirSolveJob job(game, SolveJobOptions());
+  SPIEL_CHECK_TRUE(job.Run());
+  std::unique_ptr<State> state = game->NewInitialState();
+  SPIEL_CHECK_EQ(job.Value(static_cast<const CounterAirState&>(*state)),
+                 ReferenceValue(*state));
+
+  // Following the best actions realises the value.
+  const int value = job.Value(static_cast<const CounterAirState&>(*state));
+  while (!state->IsTerminal()) {
+    const auto& counter_air_state = static_cast<const CounterAirState&>(*state);
+    SPIEL_CHECK_EQ(job.Value(counter_air_state), value);
+    state->ApplyAction(job.BestAction(counter_air_state));
+  }
+  SPIEL_CHECK_EQ(state->Returns()[0], value);
+}
+
+void ResumeTest() {
+  std::shared_ptr<const Game> game = SmallGame(2, 1, 2);
+  CounterAirSolveJob uninterrupted(game, SolveJobOptions());
+  SPIEL_CHECK_TRUE(uninterrupted.Run());
+
+  char dir[] = "/tmp/counter_air_solve_job_test.XXXXXX";
+  SPIEL_CHECK_TRUE(mkdtemp(dir) != nullptr);
+  const std::string path = std::string(dir) + "/job.ckpt";
+  SolveJobOptions options;
+  options.checkpoint_path = path;
+  options.max_nodes = 100;
+  int runs = 0;
+  bool finished = false;
+  while (!finished) {
+    // A new job each time, as after a preemption.
+    CounterAirSolveJob job(game, options);
+    SPIEL_CHECK_EQ(job.Progress().resumed, runs > 0);
+    finished = job.Run();
+    runs++;
+    if (finished) {
+      SPIEL_CHECK_EQ(job.num_states(), uninterrupted.num_states());
+      SPIEL_CHECK_EQ(job.Progress().nodes, uninterrupted.Progress().nodes);
+      std::unique_ptr<State> state = game->NewInitialState();
+      const auto& root = static_cast<const CounterAirState&>(*state);
+      SPIEL_CHECK_EQ(job.Value(root), uninterrupted.Value(root));
+    }
+  }
+  SPIEL_CHECK_GT(runs, 2);
+
+  // A finished checkpoint resumes as finished.
+  CounterAirSolveJob done(game, options);
+  SPIEL_CHECK_TRUE(done.finished());
+  SPIEL_CHECK_EQ(done.num_states(), uninterrupted.num_states());
+  SPIEL_CHECK_EQ(std::remove(path.c_str()), 0);
+  std::remove((path + ".tmp").c_str());
+  SPIEL_CHECK_EQ(rmdir(dir), 0);
+}
+
+}  // namespace
+}  // namespace counter_air
+}  // namespace open_spiel
+
+int main(int argc, char** argv) {
+  open_spiel::counter_air::MatchesReferenceTest();
+  open_spiel::counter_air::ResumeTest();
+}
@@ -0,0 +1,60 @@
+// Copyright 2019 DeepMind Technologies Limited
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Runs an exact solve of counter_air as a resumable job. Rerunning the same
+// command after a crash or preemption continues from the last checkpoint.
+
+#include <iostream>
+#include <memory>
+#include <string>
+
+#include "absl/flags/flag.h"
+#include "absl/flags/parse.h"
+#include "absl/strings/str_format.h"
+#include "absl/time/time.h"
+#include "open_spiel/games/counter_air.h"
+#include "open_spiel/games/counter_air_solve_job.h"
+#include "open_spiel/spiel.h"
+
+ABSL_FLAG(std::string, game, "counter_air", "Game string, with its parameters.");
+ABSL_FLAG(std::string, checkpoint, "", "Checkpoint file; resumed from if it exists.");
+ABSL_FLAG(int, checkpoint_minutes, 10, "Minutes between checkpoints.");
+ABSL_FLAG(int, progress_seconds, 30, "Seconds between progress lines.");
+
+int main(int argc, char** argv) {
+    absl::ParseCommandLine(argc, argv);
+    namespace ca = open_spiel::counter_air;
+    std::shared_ptr<const open_spiel::Game> game =
+        open_spiel::LoadGame(absl::GetFlag(FLAGS_game));
+
+    ca::SolveJobOptions options;
+    options.checkpoint_path = absl::GetFlag(FLAGS_checkpoint);
+    options.checkpoint_interval = absl::Minutes(absl::GetFlag(FLAGS_checkpoint_minutes));
+    options.progress_interval = absl::Seconds(absl::GetFlag(FLAGS_progress_seconds));
+    options.progress = [](const ca::SolveJobProgress &progress) {
+        std::cout << absl::StrFormat(
+                         "%.0fs: %d solved, %d nodes, stack %d, %.0f nodes/s%s\n",
+                         absl::ToDoubleSeconds(progress.elapsed), progress.solved_states,
+                         progress.nodes, progress.stack_depth,
+                         progress.nodes_per_second, progress.resumed ? " (resumed)" : "")
+                  << std::flush;
+    };
+
+    ca::CounterAirSolveJob job(game, options);
+    if (!job.Run()) return 1;
+    std::unique_ptr<open_spiel::State> state = game->NewInitialState();
+    const auto &root = static_cast<const ca::CounterAirState &>(*state);
+    std::cout << absl::StrFormat("Value %d, best opening action %d\n", job.Value(root),
+                                 job.BestAction(root));
+}
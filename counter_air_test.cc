@@ -12,6 +12,14 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "open_spiel/games/counter_air.h"
 #include "open_spiel/spiel.h"
 #include "open_spiel/tests/basic_tests.h"
 
@@ -27,10 +35,99 @@ void BasicCounterAirTests() {
   testing::RandomSimTest(*LoadGame("counter_air"), 100);
 }
 
+void ReducedGameTests() {
+  std::shared_ptr<const Game> game =
+      LoadGame("counter_air", {{"blue_fighters", GameParameter(4)},
+                               {"red_fighters", GameParameter(2)},
+                               {"red_sams", GameParameter(1)},
+                               {"num_waves", GameParameter(1)},
+                               {"num_aaa", GameParameter(1)},
+                               {"hit_threshold", GameParameter(2)}});
+  testing::RandomSimTest(*game, 100);
+  std::unique_ptr<State> state = game->NewInitialState();
+  SPIEL_CHECK_EQ(state->LegalActions().size(), 5);
+}
+
+void ExpandChildrenTests() {
+  std::shared_ptr<const Game> game = LoadGame("counter_air");
+  std::mt19937 rng(0);
+  std::array<ExpandedChild, kNumDistinctActions> children;
+  std::vector<float> observations(kNumDistinctActions * kObservationSize);
+  std::vector<float> expected(kObservationSize);
+  for (int game_num = 0; game_num < 20; game_num++) {
+    std::unique_ptr<State> state = game->NewInitialState();
+    while (!state->IsTerminal()) {
+      const auto& parent = static_cast<const CounterAirState&>(*state);
+      std::fill(observations.begin(), observations.end(), 0.0);
+      const int num_children =
+          parent.ExpandChildren(absl::MakeSpan(children),
+                                absl::MakeSpan(observations));
+      std::vector<Action> legal_actions = state->LegalActions();
+      SPIEL_CHECK_EQ(num_children, static_cast<int>(legal_actions.size()));
+      for (int i = 0; i < num_children; i++) {
+        SPIEL_CHECK_EQ(children[i].action, legal_actions[i]);
+        std::unique_ptr<State> child = state->Child(legal_actions[i]);
+        const CompactState compact =
+            static_cast<const CounterAirState&>(*child).ToCompact();
+        SPIEL_CHECK_EQ(
+            std::memcmp(&compact, &children[i].state, sizeof(CompactState)), 0);
+        std::fill(expected.begin(), expected.end(), 0.0);
+        child->ObservationTensor(0, absl::MakeSpan(expected));
+        SPIEL_CHECK_TRUE(std::equal(
+            expected.begin(), expected.end(),
+            observations.begin() + i * kObservationSize));
+        CounterAirState restored(game, children[i].state);
+        SPIEL_CHECK_EQ(restored.ToString(), child->ToString());
+      }
+      std::uniform_int_distribution<int> dist(0, num_children - 1);
+      state->ApplyAction(legal_actions[dist(rng)]);
+    }
+  }
+}
+
+// States that differ only in the fields CanonicalCompactState() clears must
+// play out identically.
+void CanonicalKeyTests() {
+  std::shared_ptr<const Game> game = LoadGame("counter_air");
+  std::mt19937 rng(0);
+  for (int game_num = 0; game_num < 200; game_num++) {
+    std::unique_ptr<State> state = game->NewInitialState();
+    while (!state->IsTerminal()) {
+      std::vector<Action> actions = state->LegalActions();
+      state->ApplyAction(actions[rng() % actions.size()]);
+      if (state->IsTerminal() || rng() % 10 != 0) continue;
+
+      CompactState perturbed =
+          static_cast<const CounterAirState&>(*state).ToCompact();
+      perturbed.num_moves = rng() % (perturbed.num_moves + 1);
+      perturbed.is_uav = !perturbed.is_uav;
+      if (perturbed.is_attacking) perturbed.attacking_box = rng() % kBoardSize;
+      std::unique_ptr<State> line = state->Clone();
+      std::unique_ptr<State> twin =
+          std::make_unique<CounterAirState>(game, perturbed);
+      while (!line->IsTerminal()) {
+        SPIEL_CHECK_EQ(
+            static_cast<const CounterAirState&>(*line).CanonicalKey(),
+            static_cast<const CounterAirState&>(*twin).CanonicalKey());
+        std::vector<Action> legal = line->LegalActions();
+        SPIEL_CHECK_EQ(legal, twin->LegalActions());
+        const Action action = legal[rng() % legal.size()];
+        line->ApplyAction(action);
+        twin->ApplyAction(action);
+      }
+      SPIEL_CHECK_TRUE(twin->IsTerminal());
+      SPIEL_CHECK_EQ(line->Returns(), twin->Returns());
+    }
+  }
+}
+
 }  // namespace
 }  // namespace counter_air
 }  // namespace open_spiel
 
 int main(int argc, char** argv) {
   open_spiel::counter_air::BasicCounterAirTests();
+  open_spiel::counter_air::ReducedGameTests();
+  open_spiel::counter_air::ExpandChildrenTests();
+  open_spiel::counter_air::CanonicalKeyTests();
 }
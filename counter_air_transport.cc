@@ -0,0 +1,265 @@
+// Copyright 2019 DeepMind Technologies Limited
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "open_spiel/games/counter_air_transport.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <condition_variable>
+#include <cstdint>
+#include <cstring>
+#include <mutex>
+#include <utility>
+
+#include "absl/strings/str_cat.h"
+#include "absl/time/clock.h"
+#include "open_spiel/spiel_utils.h"
+
+namespace open_spiel {
+namespace counter_air {
+namespace {
+
+constexpr size_t kReadChunk = 1 << 16;
+
+sockaddr_un SocketAddress(const std::string &dir, int rank) {
+    sockaddr_un address;
+    std::memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    const std::string path = absl::StrCat(dir, "/", rank, ".sock");
+    SPIEL_CHECK_LT(path.size(), sizeof(address.sun_path));
+    std::memcpy(address.sun_path, path.data(), path.size());
+    return address;
+}
+
+void SetNonBlocking(int fd) {
+    fcntl(fd, F_SETFL, fcntl(fd, F_GETFL, 0) | O_NONBLOCK);
+}
+
+int PollTimeoutMs(absl::Duration timeout) {
+    if (timeout == absl::InfiniteDuration()) return -1;
+    return static_cast<int>(absl::ToInt64Milliseconds(absl::Ceil(timeout, absl::Milliseconds(1))));
+}
+
+// All endpoints of an in-process transport.
+struct InProcessHub {
+    struct Mailbox {
+        std::mutex mutex;
+        std::condition_variable ready;
+        std::deque<std::string> messages;
+    };
+    explicit InProcessHub(int num_endpoints) : mailboxes(num_endpoints) {}
+    std::vector<Mailbox> mailboxes;
+};
+
+class InProcessTransport : public SolverTransport {
+   public:
+    InProcessTransport(std::shared_ptr<InProcessHub> hub, int rank)
+        : hub_(std::move(hub)), rank_(rank) {}
+
+    int rank() const override { return rank_; }
+    int num_endpoints() const override { return hub_->mailboxes.size(); }
+
+    void Send(int to, std::string message) override {
+        InProcessHub::Mailbox &mailbox = hub_->mailboxes.at(to);
+        {
+            std::lock_guard<std::mutex> lock(mailbox.mutex);
+            mailbox.messages.push_back(std::move(message));
+        }
+        mailbox.ready.notify_one();
+    }
+
+    bool Receive(std::string *message, absl::Duration timeout) override {
+        InProcessHub::Mailbox &mailbox = hub_->mailboxes[rank_];
+        std::unique_lock<std::mutex> lock(mailbox.mutex);
+        if (!mailbox.ready.wait_for(lock, absl::ToChronoNanoseconds(timeout),
+                                    [&]() { return !mailbox.messages.empty(); })) {
+            return false;
+        }
+        *message = std::move(mailbox.messages.front());
+        mailbox.messages.pop_front();
+        return true;
+    }
+
+   private:
+    std::shared_ptr<InProcessHub> hub_;
+    int rank_;
+};
+
+}  // namespace
+
+UnixSocketTransport::UnixSocketTransport(const std::string &dir, int rank,
+                                         int num_endpoints,
+                                         absl::Duration connect_timeout)
+    : dir_(dir),
+      rank_(rank),
+      num_endpoints_(num_endpoints),
+      connect_timeout_(connect_timeout),
+      out_fds_(num_endpoints, -1) {
+    SPIEL_CHECK_GE(rank, 0);
+    SPIEL_CHECK_LT(rank, num_endpoints);
+    const sockaddr_un address = SocketAddress(dir_, rank_);
+    unlink(address.sun_path);
+    listen_fd_ = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (listen_fd_ < 0 ||
+        bind(listen_fd_, reinterpret_cast<const sockaddr *>(&address), sizeof(address)) != 0 ||
+        listen(listen_fd_, num_endpoints) != 0) {
+        SpielFatalError(absl::StrCat("Could not listen on ", address.sun_path, ": ",
+                                     std::strerror(errno)));
+    }
+    SetNonBlocking(listen_fd_);
+}
+
+UnixSocketTransport::~UnixSocketTransport() {
+    for (int fd : out_fds_) {
+        if (fd >= 0) close(fd);
+    }
+    for (const Connection &connection : in_connections_) close(connection.fd);
+    close(listen_fd_);
+    unlink(SocketAddress(dir_, rank_).sun_path);
+}
+
+void UnixSocketTransport::Connect(int to) {
+    const sockaddr_un address = SocketAddress(dir_, to);
+    const absl::Time deadline = absl::Now() + connect_timeout_;
+    while (true) {
+        const int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+        SPIEL_CHECK_GE(fd, 0);
+        if (connect(fd, reinterpret_cast<const sockaddr *>(&address), sizeof(address)) == 0) {
+            SetNonBlocking(fd);
+            out_fds_[to] = fd;
+            return;
+        }
+        const int error = errno;
+        close(fd);
+        if ((error != ENOENT && error != ECONNREFUSED) || absl::Now() > deadline) {
+            SpielFatalError(absl::StrCat("Could not connect to ", address.sun_path, ": ",
+                                         std::strerror(error)));
+        }
+        // The peer is not up yet; keep taking deliveries while waiting.
+        Pump(absl::Milliseconds(10));
+    }
+}
+
+void UnixSocketTransport::Send(int to, std::string message) {
+    SPIEL_CHECK_GE(to, 0);
+    SPIEL_CHECK_LT(to, num_endpoints_);
+    if (to == rank_) {
+        inbox_.push_back(std::move(message));
+        return;
+    }
+    if (out_fds_[to] < 0) Connect(to);
+    const uint32_t length = message.size();
+    std::string frame(reinterpret_cast<const char *>(&length), sizeof(length));
+    frame += message;
+    size_t written = 0;
+    while (written < frame.size()) {
+        const ssize_t n = send(out_fds_[to], frame.data() + written, frame.size() - written,
+                               MSG_NOSIGNAL);
+        if (n > 0) {
+            written += n;
+        } else if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+            Pump(absl::InfiniteDuration(), out_fds_[to]);
+        } else if (n < 0 && errno != EINTR) {
+            SpielFatalError(absl::StrCat("Could not send to endpoint ", to, ": ",
+                                         std::strerror(errno)));
+        }
+    }
+}
+
+bool UnixSocketTransport::Receive(std::string *message, absl::Duration timeout) {
+    // A wakeup may only have accepted a connection or read part of a frame.
+    const absl::Time deadline = absl::Now() + timeout;
+    if (inbox_.empty()) Pump(timeout);
+    while (inbox_.empty()) {
+        const absl::Duration left = deadline - absl::Now();
+        if (left <= absl::ZeroDuration()) return false;
+        Pump(left);
+    }
+    *message = std::move(inbox_.front());
+    inbox_.pop_front();
+    return true;
+}
+
+void UnixSocketTransport::Pump(absl::Duration timeout, int writable_fd) {
+    std::vector<pollfd> fds;
+    fds.push_back({listen_fd_, POLLIN, 0});
+    for (const Connection &connection : in_connections_) {
+        fds.push_back({connection.fd, POLLIN, 0});
+    }
+    if (writable_fd >= 0) fds.push_back({writable_fd, POLLOUT, 0});
+    if (poll(fds.data(), fds.size(), PollTimeoutMs(timeout)) <= 0) return;
+
+    for (size_t i = 1; i <= in_connections_.size(); i++) {
+        if (fds[i].revents & (POLLIN | POLLHUP | POLLERR)) ReadFrom(&in_connections_[i - 1]);
+    }
+    // Closed connections were marked with fd -1.
+    for (size_t i = 0; i < in_connections_.size();) {
+        if (in_connections_[i].fd < 0) {
+            in_connections_.erase(in_connections_.begin() + i);
+        } else {
+            i++;
+        }
+    }
+    if (fds[0].revents & POLLIN) {
+        int fd;
+        while ((fd = accept(listen_fd_, nullptr, nullptr)) >= 0) {
+            SetNonBlocking(fd);
+            in_connections_.push_back({fd, ""});
+        }
+    }
+}
+
+void UnixSocketTransport::ReadFrom(Connection *connection) {
+    char chunk[kReadChunk];
+    while (true) {
+        const ssize_t n = read(connection->fd, chunk, sizeof(chunk));
+        if (n > 0) {
+            connection->buffer.append(chunk, n);
+            continue;
+        }
+        if (n == 0 || (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR)) {
+            close(connection->fd);
+            connection->fd = -1;
+        }
+        if (n < 0 && errno == EINTR) continue;
+        break;
+    }
+    size_t offset = 0;
+    std::string &buffer = connection->buffer;
+    while (buffer.size() - offset >= sizeof(uint32_t)) {
+        uint32_t length;
+        std::memcpy(&length, buffer.data() + offset, sizeof(length));
+        if (buffer.size() - offset - sizeof(length) < length) break;
+        inbox_.push_back(buffer.substr(offset + sizeof(length), length));
+        offset += sizeof(length) + length;
+    }
+    buffer.erase(0, offset);
+}
+
+std::vector<std::unique_ptr<SolverTransport>> MakeInProcessTransports(int num_endpoints) {
+    auto hub = std::make_shared<InProcessHub>(num_endpoints);
+    std::vector<std::unique_ptr<SolverTransport>> transports;
+    for (int rank = 0; rank < num_endpoints; rank++) {
+        transports.push_back(std::make_unique<InProcessTransport>(hub, rank));
+    }
+    return transports;
+}
+
+}  // namespace counter_air
+}  // namespace open_spiel
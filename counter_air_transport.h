@@ -0,0 +1,93 @@
+// Copyright 2019 DeepMind Technologies Limited
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef OPEN_SPIEL_GAMES_COUNTER_AIR_TRANSPORT_H_
+#define OPEN_SPIEL_GAMES_COUNTER_AIR_TRANSPORT_H_
+
+#include <deque>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "absl/time/time.h"
+
+// Message transports between the processes of a distributed counter_air
+// computation. A transport connects num_endpoints endpoints, numbered from 0;
+// each process holds one. Messages are opaque byte strings, delivered whole
+// and in order between any two endpoints.
+
+namespace open_spiel {
+namespace counter_air {
+
+class SolverTransport {
+   public:
+    virtual ~SolverTransport() = default;
+
+    virtual int rank() const = 0;
+    virtual int num_endpoints() const = 0;
+    // May block until the receiver has room, but keeps accepting incoming
+    // messages meanwhile, so that two endpoints sending to each other cannot
+    // deadlock.
+    virtual void Send(int to, std::string message) = 0;
+    // Waits up to `timeout` for a message; returns false if none arrived.
+    virtual bool Receive(std::string *message, absl::Duration timeout) = 0;
+};
+
+// Unix-domain stream sockets: endpoint r listens on "<dir>/<r>.sock" and
+// connects to the others on first use, retrying until `connect_timeout`, so
+// the processes may start in any order. Messages are framed by a 4-byte
+// length.
+class UnixSocketTransport : public SolverTransport {
+   public:
+    UnixSocketTransport(const std::string &dir, int rank, int num_endpoints,
+                        absl::Duration connect_timeout = absl::Seconds(30));
+    ~UnixSocketTransport() override;
+    UnixSocketTransport(const UnixSocketTransport &) = delete;
+    UnixSocketTransport &operator=(const UnixSocketTransport &) = delete;
+
+    int rank() const override { return rank_; }
+    int num_endpoints() const override { return num_endpoints_; }
+    void Send(int to, std::string message) override;
+    bool Receive(std::string *message, absl::Duration timeout) override;
+
+   private:
+    struct Connection {
+        int fd;
+        std::string buffer;  // Bytes read but not yet framed.
+    };
+
+    void Connect(int to);
+    // Accepts connections and reads whatever is available, waiting up to
+    // `timeout` for something to happen. When `writable_fd` is given, also
+    // returns once it can be written to.
+    void Pump(absl::Duration timeout, int writable_fd = -1);
+    void ReadFrom(Connection *connection);
+
+    std::string dir_;
+    int rank_;
+    int num_endpoints_;
+    absl::Duration connect_timeout_;
+    int listen_fd_ = -1;
+    std::vector<int> out_fds_;
+    std::vector<Connection> in_connections_;
+    std::deque<std::string> inbox_;
+};
+
+// Endpoints in one process, for threads standing in for processes.
+std::vector<std::unique_ptr<SolverTransport>> MakeInProcessTransports(int num_endpoints);
+
+}  // namespace counter_air
+}  // namespace open_spiel
+
+#endif  // OPEN_SPIEL_GAMES_COUNTER_AIR_TRANSPORT_H_
@@ -0,0 +1,110 @@
+// Copyright 2019 DeepMind Technologies Limited
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "open_spiel/games/counter_air_transport.h"
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "absl/strings/str_cat.h"
+#include "absl/time/time.h"
+#include "open_spiel/spiel_utils.h"
+
+namespace open_spiel {
+namespace counter_air {
+namespace {
+
+constexpr int kNumMessages = 32;
+
+std::string Message(int from, int index) {
+  // Large enough to fill the socket buffers several times over.
+  return absl::StrCat(from, ":", index, ":", std::string(index * 16384, 'x'));
+}
+
+// Sends every message before receiving any, which deadlocks unless Send keeps
+// taking deliveries while it waits.
+bool Exchange(SolverTransport* transport, int peer) {
+  for (int i = 0; i < kNumMessages; i++) {
+    transport->Send(peer, Message(transport->rank(), i));
+  }
+  std::string message;
+  for (int i = 0; i < kNumMessages; i++) {
+    if (!transport->Receive(&message, absl::Seconds(30))) return false;
+    if (message != Message(peer, i)) return false;
+  }
+  return !transport->Receive(&message, absl::ZeroDuration());
+}
+
+void InProcessTest() {
+  std::vector<std::unique_ptr<SolverTransport>> transports =
+      MakeInProcessTransports(3);
+  SPIEL_CHECK_EQ(transports[2]->rank(), 2);
+  SPIEL_CHECK_EQ(transports[2]->num_endpoints(), 3);
+  std::string message;
+  SPIEL_CHECK_FALSE(transports[0]->Receive(&message, absl::ZeroDuration()));
+  transports[1]->Send(0, "a");
+  transports[2]->Send(0, "b");
+  transports[1]->Send(0, "c");
+  SPIEL_CHECK_TRUE(transports[0]->Receive(&message, absl::ZeroDuration()));
+  SPIEL_CHECK_EQ(message, "a");
+  SPIEL_CHECK_TRUE(transports[0]->Receive(&message, absl::ZeroDuration()));
+  SPIEL_CHECK_EQ(message, "b");
+  SPIEL_CHECK_TRUE(transports[0]->Receive(&message, absl::ZeroDuration()));
+  SPIEL_CHECK_EQ(message, "c");
+  SPIEL_CHECK_FALSE(transports[1]->Receive(&message, absl::ZeroDuration()));
+}
+
+void UnixSocketTest() {
+  char dir[] = "/tmp/counter_air_transport_test.XXXXXX";
+  SPIEL_CHECK_TRUE(mkdtemp(dir) != nullptr);
+  const pid_t pid = fork();
+  SPIEL_CHECK_GE(pid, 0);
+  if (pid == 0) {
+    bool ok;
+    {
+      UnixSocketTransport transport(dir, 1, 2);
+      ok = Exchange(&transport, 0);
+    }
+    _exit(ok ? 0 : 1);
+  }
+  {
+    UnixSocketTransport transport(dir, 0, 2);
+    SPIEL_CHECK_TRUE(Exchange(&transport, 1));
+    // Messages to self skip the socket.
+    transport.Send(0, "self");
+    std::string message;
+    SPIEL_CHECK_TRUE(transport.Receive(&message, absl::ZeroDuration()));
+    SPIEL_CHECK_EQ(message, "self");
+  }
+  int status;
+  SPIEL_CHECK_EQ(waitpid(pid, &status, 0), pid);
+  SPIEL_CHECK_TRUE(WIFEXITED(status));
+  SPIEL_CHECK_EQ(WEXITSTATUS(status), 0);
+  // Both transports removed their sockets.
+  SPIEL_CHECK_EQ(rmdir(dir), 0);
+}
+
+}  // namespace
+}  // namespace counter_air
+}  // namespace open_spiel
+
+int main(int argc, char** argv) {
+  open_spiel::counter_air::InProcessTest();
+  open_spiel::counter_air::UnixSocketTest();
+}
@@ -0,0 +1,228 @@
+// Copyright 2019 DeepMind Technologies Limited
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "open_spiel/games/counter_air_tt.h"
+
+#include <sys/mman.h>
+
+#include <algorithm>
+#include <limits>
+#include <new>
+
+#include "open_spiel/spiel_utils.h"
+
+namespace open_spiel {
+namespace counter_air {
+namespace {
+
+// Layout of the data word.
+constexpr int kValueShift = 0;    // 16 bits, two's complement
+constexpr int kDepthShift = 16;   // 8 bits
+constexpr int kBoundShift = 24;   // 2 bits
+constexpr int kMoveShift = 26;    // 4 bits
+constexpr int kGenerationShift = 32;  // 8 bits
+constexpr uint64_t kNoMove = 15;
+
+constexpr size_t kHugePageSize = size_t{2} << 20;
+
+// Entries of older searches lose this much depth per generation when picking
+// a victim.
+constexpr int kAgePenalty = 8;
+
+uint64_t PackData(int value, int depth, TTBound bound, Action move,
+                  uint8_t generation) {
+    const uint64_t packed_move = move == kInvalidAction ? kNoMove : move;
+    return (static_cast<uint64_t>(static_cast<uint16_t>(value)) << kValueShift) |
+           (static_cast<uint64_t>(depth) << kDepthShift) |
+           (static_cast<uint64_t>(bound) << kBoundShift) |
+           (packed_move << kMoveShift) |
+           (static_cast<uint64_t>(generation) << kGenerationShift);
+}
+
+int DataValue(uint64_t data) {
+    return static_cast<int16_t>((data >> kValueShift) & 0xffff);
+}
+int DataDepth(uint64_t data) { return (data >> kDepthShift) & 0xff; }
+TTBound DataBound(uint64_t data) {
+    return static_cast<TTBound>((data >> kBoundShift) & 3);
+}
+Action DataMove(uint64_t data) {
+    const uint64_t move = (data >> kMoveShift) & 0xf;
+    return move == kNoMove ? kInvalidAction : static_cast<Action>(move);
+}
+uint8_t DataGeneration(uint64_t data) { return (data >> kGenerationShift) & 0xff; }
+
+}  // namespace
+
+TranspositionTable::TranspositionTable(const TranspositionTableOptions &options) {
+    const size_t bytes = std::max<size_t>(options.size_mb, 1) << 20;
+    num_buckets_ = 1;
+    while (num_buckets_ * 2 * sizeof(Bucket) <= bytes) num_buckets_ *= 2;
+    mapped_bytes_ = num_buckets_ * sizeof(Bucket);
+
+    void *memory = MAP_FAILED;
+    if (options.huge_pages) {
+#ifdef MAP_HUGETLB
+        const size_t huge_bytes =
+            (mapped_bytes_ + kHugePageSize - 1) / kHugePageSize * kHugePageSize;
+        memory = mmap(nullptr, huge_bytes, PROT_READ | PROT_WRITE,
+                      MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+        if (memory != MAP_FAILED) {
+            mapped_bytes_ = huge_bytes;
+            huge_pages_ = true;
+        }
+#endif
+    }
+    if (memory == MAP_FAILED) {
+        memory = mmap(nullptr, mapped_bytes_, PROT_READ | PROT_WRITE,
+                      MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (memory == MAP_FAILED) {
+            SpielFatalError("Could not allocate the transposition table.");
+        }
+#ifdef MADV_HUGEPAGE
+        // Transparent huge pages, if the kernel has them enabled.
+        if (options.huge_pages) {
+            huge_pages_ = madvise(memory, mapped_bytes_, MADV_HUGEPAGE) == 0;
+        }
+#endif
+    }
+    buckets_ = static_cast<Bucket *>(memory);
+    for (size_t i = 0; i < num_buckets_; i++) {
+        new (&buckets_[i]) Bucket();
+    }
+}
+
+TranspositionTable::~TranspositionTable() { munmap(buckets_, mapped_bytes_); }
+
+TranspositionTable::Counters &TranspositionTable::LocalCounters() const {
+    static std::atomic<int> next_shard{0};
+    thread_local const int shard =
+        next_shard.fetch_add(1, std::memory_order_relaxed) % kNumCounterShards;
+    return counters_[shard];
+}
+
+bool TranspositionTable::Probe(uint64_t key, TTEntry *entry) const {
+    Counters &counters = LocalCounters();
+    counters.probes.fetch_add(1, std::memory_order_relaxed);
+    for (const Slot &slot : BucketFor(key).slots) {
+        const uint64_t data = slot.data.load(std::memory_order_relaxed);
+        const uint64_t check = slot.check.load(std::memory_order_relaxed);
+        if ((check ^ data) != key || DataBound(data) == TTBound::kNone) continue;
+        entry->value = DataValue(data);
+        entry->depth = DataDepth(data);
+        entry->bound = DataBound(data);
+        entry->move = DataMove(data);
+        counters.hits.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
+    return false;
+}
+
+void TranspositionTable::Store(uint64_t key, int value, int depth, TTBound bound,
+                               Action move) {
+    SPIEL_CHECK_NE(static_cast<int>(bound), static_cast<int>(TTBound::kNone));
+    SPIEL_CHECK_GE(value, std::numeric_limits<int16_t>::min());
+    SPIEL_CHECK_LE(value, std::numeric_limits<int16_t>::max());
+    SPIEL_CHECK_GE(depth, 0);
+    SPIEL_CHECK_LE(depth, kMaxDepth);
+    const uint8_t generation = generation_.load(std::memory_order_relaxed);
+
+    Bucket &bucket = BucketFor(key);
+    Slot *victim = nullptr;
+    uint64_t victim_data = 0;
+    int victim_score = std::numeric_limits<int>::max();
+    for (Slot &slot : bucket.slots) {
+        const uint64_t data = slot.data.load(std::memory_order_relaxed);
+        const uint64_t check = slot.check.load(std::memory_order_relaxed);
+        if (DataBound(data) != TTBound::kNone && (check ^ data) == key) {
+            // Keep a deeper result of this search unless the new one is exact.
+            if (DataGeneration(data) == generation && DataDepth(data) > depth &&
+                bound != TTBound::kExact) {
+                return;
+            }
+            victim = &slot;
+            victim_data = data;
+            break;
+        }
+        const int age = static_cast<uint8_t>(generation - DataGeneration(data));
+        const int score = DataBound(data) == TTBound::kNone
+                              ? std::numeric_limits<int>::min()
+                              : DataDepth(data) - kAgePenalty * age;
+        if (score < victim_score) {
+            victim = &slot;
+            victim_data = data;
+            victim_score = score;
+        }
+    }
+
+    Counters &counters = LocalCounters();
+    counters.stores.fetch_add(1, std::memory_order_relaxed);
+    const uint64_t victim_key =
+        victim->check.load(std::memory_order_relaxed) ^ victim_data;
+    if (DataBound(victim_data) != TTBound::kNone && victim_key != key) {
+        counters.replacements.fetch_add(1, std::memory_order_relaxed);
+    }
+    const uint64_t data = PackData(value, depth, bound, move, generation);
+    victim->data.store(data, std::memory_order_relaxed);
+    victim->check.store(key ^ data, std::memory_order_relaxed);
+}
+
+void TranspositionTable::NewSearch() {
+    generation_.fetch_add(1, std::memory_order_relaxed);
+}
+
+void TranspositionTable::Clear() {
+    for (size_t i = 0; i < num_buckets_; i++) {
+        for (Slot &slot : buckets_[i].slots) {
+            slot.data.store(0, std::memory_order_relaxed);
+            slot.check.store(0, std::memory_order_relaxed);
+        }
+    }
+    for (Counters &counters : counters_) {
+        counters.probes.store(0, std::memory_order_relaxed);
+        counters.hits.store(0, std::memory_order_relaxed);
+        counters.stores.store(0, std::memory_order_relaxed);
+        counters.replacements.store(0, std::memory_order_relaxed);
+    }
+}
+
+TTStats TranspositionTable::Stats() const {
+    TTStats stats;
+    for (const Counters &counters : counters_) {
+        stats.probes += counters.probes.load(std::memory_order_relaxed);
+        stats.hits += counters.hits.load(std::memory_order_relaxed);
+        stats.stores += counters.stores.load(std::memory_order_relaxed);
+        stats.replacements += counters.replacements.load(std::memory_order_relaxed);
+    }
+    return stats;
+}
+
+double TranspositionTable::Occupancy() const {
+    const size_t num_sampled = std::min<size_t>(num_buckets_, 1024);
+    const uint8_t generation = generation_.load(std::memory_order_relaxed);
+    int used = 0;
+    for (size_t i = 0; i < num_sampled; i++) {
+        for (const Slot &slot : buckets_[i].slots) {
+            const uint64_t data = slot.data.load(std::memory_order_relaxed);
+            if (DataBound(data) != TTBound::kNone &&
+                DataGeneration(data) == generation) {
+                used++;
+            }
+        }
+    }
+    return static_cast<double>(used) / (num_sampled * kBucketSize);
+}
+
+}  // namespace counter_air
+}  // namespace open_spiel
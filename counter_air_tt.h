@@ -0,0 +1,134 @@
+// Copyright 2019 DeepMind Technologies Limited
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef OPEN_SPIEL_GAMES_COUNTER_AIR_TT_H_
+#define OPEN_SPIEL_GAMES_COUNTER_AIR_TT_H_
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+#include "open_spiel/games/counter_air.h"
+#include "open_spiel/spiel.h"
+
+// Fixed-size transposition table shared by any number of search threads,
+// keyed on CounterAirState::StateKey().
+//
+// Entries are 16 bytes: a data word and the key xor-ed with it. Both words are
+// written and read with relaxed atomics and without locks; a probe that sees
+// the halves of two different writes fails the key check and reads as a miss,
+// so a torn entry is never returned. Four entries share a 64-byte bucket.
+//
+// Within a bucket a store replaces, in order: the entry of the same key
+// (unless that one is deeper and from the current search), an empty entry, or
+// the entry with the lowest depth after an aging penalty for entries of
+// earlier searches.
+
+namespace open_spiel {
+namespace counter_air {
+
+enum class TTBound : uint8_t {
+    kNone = 0,
+    kLower = 1,  // The value is at least the stored one.
+    kUpper = 2,  // The value is at most the stored one.
+    kExact = 3,
+};
+
+struct TTEntry {
+    int value;
+    int depth;
+    TTBound bound;
+    Action move;  // kInvalidAction if none was stored.
+};
+
+struct TTStats {
+    uint64_t probes = 0;
+    uint64_t hits = 0;
+    uint64_t stores = 0;
+    uint64_t replacements = 0;  // Stores that evicted another key.
+
+    double HitRate() const {
+        return probes == 0 ? 0.0 : static_cast<double>(hits) / probes;
+    }
+};
+
+struct TranspositionTableOptions {
+    size_t size_mb = 64;
+    // Backs the table with huge pages where the system allows it, falling back
+    // to normal pages.
+    bool huge_pages = false;
+};
+
+class TranspositionTable {
+   public:
+    inline static constexpr int kBucketSize = 4;
+    inline static constexpr int kMaxDepth = 255;
+
+    explicit TranspositionTable(const TranspositionTableOptions &options = {});
+    ~TranspositionTable();
+    TranspositionTable(const TranspositionTable &) = delete;
+    TranspositionTable &operator=(const TranspositionTable &) = delete;
+
+    // Returns true and fills `entry` if `key` is in the table.
+    bool Probe(uint64_t key, TTEntry *entry) const;
+    // `value` must fit in 16 bits and `depth` in [0, kMaxDepth].
+    void Store(uint64_t key, int value, int depth, TTBound bound,
+               Action move = kInvalidAction);
+
+    // Ages the current entries; call once before each new search.
+    void NewSearch();
+    // Not thread-safe.
+    void Clear();
+
+    TTStats Stats() const;
+    // Fraction of sampled entries written by the current search.
+    double Occupancy() const;
+    size_t num_entries() const { return num_buckets_ * kBucketSize; }
+    bool huge_pages() const { return huge_pages_; }
+
+   private:
+    struct Slot {
+        std::atomic<uint64_t> check{0};  // key ^ data
+        std::atomic<uint64_t> data{0};
+    };
+    struct alignas(64) Bucket {
+        std::array<Slot, kBucketSize> slots;
+    };
+    struct alignas(64) Counters {
+        std::atomic<uint64_t> probes{0};
+        std::atomic<uint64_t> hits{0};
+        std::atomic<uint64_t> stores{0};
+        std::atomic<uint64_t> replacements{0};
+    };
+    inline static constexpr int kNumCounterShards = 64;
+
+    Bucket &BucketFor(uint64_t key) const {
+        return buckets_[key & (num_buckets_ - 1)];
+    }
+    Counters &LocalCounters() const;
+
+    Bucket *buckets_;
+    size_t num_buckets_;
+    size_t mapped_bytes_;
+    bool huge_pages_ = false;
+    std::atomic<uint8_t> generation_{0};
+    // Sharded by thread to keep the counters off a single cache line.
+    mutable std::array<Counters, kNumCounterShards> counters_;
+};
+
+}  // namespace counter_air
+}  // namespace open_spiel
+
+#endif  // OPEN_SPIEL_GAMES_COUNTER_AIR_TT_H_
@@ -0,0 +1,140 @@
+// Copyright 2019 DeepMind Technologies Limited
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "open_spiel/games/counter_air_tt.h"
+
+#include <memory>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include "open_spiel/games/counter_air.h"
+#include "open_spiel/spiel.h"
+#include "open_spiel/spiel_utils.h"
+
+namespace open_spiel {
+namespace counter_air {
+namespace {
+
+void StoreAndProbeTest() {
+  TranspositionTable table({/*size_mb=*/1});
+  TTEntry entry;
+  SPIEL_CHECK_FALSE(table.Probe(0, &entry));
+  SPIEL_CHECK_FALSE(table.Probe(12345, &entry));
+
+  table.Store(12345, -300, 7, TTBound::kLower, 11);
+  SPIEL_CHECK_TRUE(table.Probe(12345, &entry));
+  SPIEL_CHECK_EQ(entry.value, -300);
+  SPIEL_CHECK_EQ(entry.depth, 7);
+  SPIEL_CHECK_TRUE(entry.bound == TTBound::kLower);
+  SPIEL_CHECK_EQ(entry.move, 11);
+
+  // A shallower bound of the same search does not replace a deeper one...
+  table.Store(12345, 5, 3, TTBound::kUpper);
+  SPIEL_CHECK_TRUE(table.Probe(12345, &entry));
+  SPIEL_CHECK_EQ(entry.depth, 7);
+  // ...but an exact value does.
+  table.Store(12345, 5, 3, TTBound::kExact);
+  SPIEL_CHECK_TRUE(table.Probe(12345, &entry));
+  SPIEL_CHECK_EQ(entry.value, 5);
+  SPIEL_CHECK_EQ(entry.move, kInvalidAction);
+
+  TTStats stats = table.Stats();
+  SPIEL_CHECK_EQ(stats.probes, 5);
+  SPIEL_CHECK_EQ(stats.hits, 3);
+  SPIEL_CHECK_EQ(stats.stores, 2);
+
+  table.Clear();
+  SPIEL_CHECK_FALSE(table.Probe(12345, &entry));
+  SPIEL_CHECK_EQ(table.Stats().stores, 0);
+}
+
+void ReplacementTest() {
+  TranspositionTable table({/*size_mb=*/1});
+  const uint64_t stride = table.num_entries() / TranspositionTable::kBucketSize;
+  // Fill one bucket with entries of different depths.
+  for (int i = 0; i < TranspositionTable::kBucketSize; i++) {
+    table.Store(1 + i * stride, i, 10 + i, TTBound::kExact);
+  }
+  // The shallowest entry is evicted.
+  table.Store(1 + 4 * stride, 0, 1, TTBound::kExact);
+  TTEntry entry;
+  SPIEL_CHECK_FALSE(table.Probe(1, &entry));
+  SPIEL_CHECK_TRUE(table.Probe(1 + 4 * stride, &entry));
+  SPIEL_CHECK_EQ(table.Stats().replacements, 1);
+
+  // After enough searches the old deep entries give way to new shallow ones.
+  for (int i = 0; i < 4; i++) table.NewSearch();
+  SPIEL_CHECK_EQ(table.Occupancy(), 0.0);
+  table.Store(1 + 5 * stride, 0, 2, TTBound::kExact);
+  table.Store(1 + 6 * stride, 0, 2, TTBound::kExact);
+  SPIEL_CHECK_TRUE(table.Probe(1 + 5 * stride, &entry));
+  SPIEL_CHECK_TRUE(table.Probe(1 + 6 * stride, &entry));
+  SPIEL_CHECK_FALSE(table.Probe(1 + stride, &entry));
+  SPIEL_CHECK_TRUE(table.Probe(1 + 3 * stride, &entry));
+}
+
+// Threads hammer a tiny table with entries whose value is a function of the
+// key; a torn entry would show up as a mismatch.
+void ConcurrentTest() {
+  TranspositionTable table({/*size_mb=*/1});
+  constexpr int kNumThreads = 8;
+  constexpr int kNumKeys = 1 << 18;
+  auto value_of = [](uint64_t key) { return static_cast<int>(key % 20011) - 10000; };
+  std::vector<std::thread> threads;
+  for (int t = 0; t < kNumThreads; t++) {
+    threads.emplace_back([&table, &value_of, t]() {
+      std::mt19937_64 rng(t);
+      TTEntry entry;
+      for (int i = 0; i < 200000; i++) {
+        const uint64_t key = rng() % kNumKeys * 0x9e3779b97f4a7c15ULL;
+        if (table.Probe(key, &entry)) {
+          SPIEL_CHECK_EQ(entry.value, value_of(key));
+          SPIEL_CHECK_EQ(entry.depth, static_cast<int>(key >> 56));
+        } else {
+          table.Store(key, value_of(key), key >> 56, TTBound::kExact,
+                      key % kNumDistinctActions);
+        }
+      }
+    });
+  }
+  for (std::thread &thread : threads) thread.join();
+  TTStats stats = table.Stats();
+  SPIEL_CHECK_EQ(stats.probes, kNumThreads * 200000);
+  SPIEL_CHECK_EQ(stats.hits + stats.stores, stats.probes);
+  SPIEL_CHECK_GT(stats.HitRate(), 0.0);
+}
+
+void HugePagesTest() {
+  // Falls back to normal pages where huge pages are not available.
+  TranspositionTable table({/*size_mb=*/4, /*huge_pages=*/true});
+  std::shared_ptr<const Game> game = LoadGame("counter_air");
+  std::unique_ptr<State> state = game->NewInitialState();
+  const uint64_t key = static_cast<const CounterAirState &>(*state).StateKey();
+  table.Store(key, 1, 0, TTBound::kExact, state->LegalActions()[0]);
+  TTEntry entry;
+  SPIEL_CHECK_TRUE(table.Probe(key, &entry));
+  SPIEL_CHECK_EQ(entry.move, state->LegalActions()[0]);
+}
+
+}  // namespace
+}  // namespace counter_air
+}  // namespace open_spiel
+
+int main(int argc, char** argv) {
+  open_spiel::counter_air::StoreAndProbeTest();
+  open_spiel::counter_air::ReplacementTest();
+  open_spiel::counter_air::ConcurrentTest();
+  open_spiel::counter_air::HugePagesTest();
+}
@@ -0,0 +1,66 @@
+// Copyright 2019 DeepMind Technologies Limited
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Fits the counter_air evaluator weights to rollout-scored positions and
+// prints them in the form of kDefaultEvalWeights.
+
+#include <iostream>
+#include <memory>
+#include <vector>
+
+#include "absl/flags/flag.h"
+#include "absl/flags/parse.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/str_join.h"
+#include "open_spiel/games/counter_air.h"
+#include "open_spiel/games/counter_air_eval.h"
+#include "open_spiel/spiel.h"
+
+ABSL_FLAG(int, num_games, 200, "Random games to sample positions from.");
+ABSL_FLAG(double, sample_rate, 0.1, "Fraction of the positions that are scored.");
+ABSL_FLAG(int, rollouts_per_sample, 200, "Random playouts per scored position.");
+ABSL_FLAG(int, iterations, 5000, "Gradient descent iterations.");
+ABSL_FLAG(double, learning_rate, 0.5, "Gradient descent step size.");
+ABSL_FLAG(int, seed, 0, "Seed for the games and playouts.");
+
+int main(int argc, char** argv) {
+    absl::ParseCommandLine(argc, argv);
+    namespace ca = open_spiel::counter_air;
+    std::shared_ptr<const open_spiel::Game> game = open_spiel::LoadGame("counter_air");
+    const ca::CounterAirConfig &config =
+        static_cast<const ca::CounterAirGame &>(*game).config();
+
+    std::vector<ca::EvalSample> samples = ca::RolloutEvalSamples(
+        *game, absl::GetFlag(FLAGS_num_games), absl::GetFlag(FLAGS_sample_rate),
+        absl::GetFlag(FLAGS_rollouts_per_sample), absl::GetFlag(FLAGS_seed));
+    // Hold out every fifth sample to check the fit.
+    std::vector<ca::EvalSample> train, test;
+    for (size_t i = 0; i < samples.size(); i++) {
+        (i % 5 == 4 ? test : train).push_back(samples[i]);
+    }
+
+    ca::EvalFitOptions options;
+    options.iterations = absl::GetFlag(FLAGS_iterations);
+    options.learning_rate = absl::GetFlag(FLAGS_learning_rate);
+    const ca::EvalWeights weights =
+        ca::FitEvalWeights(train, config, ca::kDefaultEvalWeights, options);
+
+    const ca::CounterAirEvaluator before(config);
+    const ca::CounterAirEvaluator after(config, weights);
+    std::cout << absl::StrCat("Samples: ", train.size(), " train, ", test.size(),
+                              " held out\n");
+    std::cout << absl::StrCat("Held-out loss: ", ca::EvalLoss(before, test), " -> ",
+                              ca::EvalLoss(after, test), "\n");
+    std::cout << absl::StrCat("{", absl::StrJoin(weights, ", "), "}\n");
+}